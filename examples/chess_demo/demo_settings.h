@@ -28,7 +28,7 @@ struct DemoTemplate
     T<iris::InProcess> maximum;
     T<draw::SizeGroup> imageSize;
     T<iris::ChessChainNodeSettingsGroup> nodeSettings;
-    T<iris::ChessChainGroup> chess;
+    T<iris::ChessChainGroup<double>> chess;
     T<iris::ChessShapeGroup> chessShape;
     T<tau::ColorMapSettingsGroup<int32_t>> color;
 
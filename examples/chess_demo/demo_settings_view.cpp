@@ -17,7 +17,7 @@ DemoSettingsView::DemoSettingsView(
     wxpex::LayoutOptions layoutOptions{};
     layoutOptions.labelFlags = wxALIGN_RIGHT;
 
-    auto chess = new iris::ChessChainSettingsView(
+    auto chess = new iris::ChessChainSettingsView<double>(
         this,
         control.chess,
         &nodeSettings,
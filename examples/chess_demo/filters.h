@@ -13,9 +13,9 @@
 class Filters
 {
 public:
-    using SourceNode = typename iris::ChessChain::SourceNode;
+    using SourceNode = typename iris::ChessChain<double>::SourceNode;
     using Color = iris::ThreadsafeColorMap<int32_t>;
-    using Chess = iris::ChessChain;
+    using Chess = iris::ChessChain<double>;
 
     iris::Cancel cancel;
     SourceNode source;
@@ -30,7 +30,7 @@ struct DemoTemplate
     T<draw::SizeGroup> imageSize;
     T<iris::MaskGroup> mask;
     T<iris::LevelGroup<int32_t>> level;
-    T<iris::LinesChainGroup> lines;
+    T<iris::LinesChainGroup<double>> lines;
     T<tau::ColorMapSettingsGroup<int32_t>> color;
 
     static constexpr auto fields = DemoFields<DemoTemplate>::fields;
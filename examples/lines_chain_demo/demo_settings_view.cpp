@@ -31,7 +31,7 @@ DemoSettingsView::DemoSettingsView(
         {},
         layoutOptions);
 
-    auto lines = new iris::LinesChainSettingsView(
+    auto lines = new iris::LinesChainSettingsView<double>(
         this,
         control.lines,
         {},
@@ -19,7 +19,7 @@ public:
     iris::DefaultSource source;
     iris::DefaultMaskNode mask;
     iris::DefaultLevelAdjustNode level;
-    iris::DefaultLinesChain lines;
+    iris::DefaultLinesChain<double> lines;
     Color color;
 
     Filters(const DemoControl &controls);
@@ -25,7 +25,7 @@ struct DemoTemplate
     T<iris::InProcess> maximum;
     T<iris::MaskGroup> mask;
     T<iris::LevelGroup<int32_t>> level;
-    T<iris::VertexChainGroup> vertexChain;
+    T<iris::VertexChainGroup<double>> vertexChain;
     T<tau::ColorMapSettingsGroup<int32_t>> color;
 
     static constexpr auto fields = DemoFields<DemoTemplate>::fields;
@@ -31,7 +31,7 @@ DemoSettingsView::DemoSettingsView(
         {},
         layoutOptions);
 
-    auto vertexSettings = new iris::VertexChainSettingsView(
+    auto vertexSettings = new iris::VertexChainSettingsView<double>(
         this,
         control.vertexChain,
         {},
@@ -19,7 +19,7 @@ public:
 
     using MaskNode = iris::Node<SourceNode, Mask, iris::MaskControl>;
     using LevelNode = iris::LevelAdjustNode<MaskNode, int32_t, double>;
-    using VertexChain = iris::VertexChain<LevelNode>;
+    using VertexChain = iris::VertexChain<double, LevelNode>;
 
     iris::Cancel cancel;
     SourceNode source;
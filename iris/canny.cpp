@@ -5,6 +5,9 @@ namespace iris
 {
 
 
+template struct CannyResult<float>;
+template class Canny<float>;
+
 template struct CannyResult<double>;
 template class Canny<double>;
 
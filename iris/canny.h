@@ -1,14 +1,18 @@
 #pragma once
 
 
+#include <atomic>
 #include <future>
 #include <vector>
 #include <deque>
+#include <limits>
+#include <optional>
 #include <tau/eigen.h>
 #include <tau/planar.h>
 #include <tau/color.h>
 #include <tau/color_maps/rgb.h>
 
+#include "iris/error.h"
 #include "iris/canny_settings.h"
 #include "iris/gradient.h"
 #include "iris/chunks.h"
@@ -22,36 +26,191 @@ namespace iris
 {
 
 
+CREATE_EXCEPTION(CannyError, IrisError);
+
+
+// Edge pixels stored as a structure of arrays.
+// Coordinates use 16 bits, which limits the image to 65536 rows and columns.
+struct CannyEdges
+{
+    using Coordinate = uint16_t;
+    using Index = Eigen::Index;
+
+    static constexpr Index maximumDimension =
+        Index{std::numeric_limits<Coordinate>::max()} + 1;
+
+    std::vector<Coordinate> rows;
+    std::vector<Coordinate> columns;
+
+    // Normalized gradient magnitude.
+    std::vector<float> weights;
+
+    // Gradient phase in degrees (0 to 360).
+    std::vector<float> phases;
+
+    static void CheckSize(Index rowCount, Index columnCount)
+    {
+        if (rowCount > maximumDimension || columnCount > maximumDimension)
+        {
+            throw CannyError("Image is too large for 16-bit edge coordinates");
+        }
+    }
+
+    size_t size() const
+    {
+        return this->rows.size();
+    }
+
+    bool empty() const
+    {
+        return this->rows.empty();
+    }
+
+    void reserve(size_t count)
+    {
+        this->rows.reserve(count);
+        this->columns.reserve(count);
+        this->weights.reserve(count);
+        this->phases.reserve(count);
+    }
+
+    void PushBack(Index row, Index column, float weight, float phase)
+    {
+        this->rows.push_back(static_cast<Coordinate>(row));
+        this->columns.push_back(static_cast<Coordinate>(column));
+        this->weights.push_back(weight);
+        this->phases.push_back(phase);
+    }
+
+    void Append(const CannyEdges &other)
+    {
+        auto append = [](auto &target, const auto &source)
+        {
+            target.insert(
+                std::end(target),
+                std::begin(source),
+                std::end(source));
+        };
+
+        append(this->rows, other.rows);
+        append(this->columns, other.columns);
+        append(this->weights, other.weights);
+        append(this->phases, other.phases);
+    }
+};
+
+
 template<typename Float>
 struct CannyResult
 {
-    using Matrix =
-        Eigen::Matrix<Float, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+    using Index = Eigen::Index;
+
+    // Compact planes, about 9 bytes per pixel.
+    using Magnitude =
+        Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
+    using Phase = Magnitude;
+
+    using Edges =
+        Eigen::Matrix<uint8_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
+    // Normalized gradient magnitude of the edge pixels.
+    Magnitude magnitude;
+
+    // Gradient phase in degrees (0 to 360).
+    // Only the edge pixels are computed.
+    Phase phase;
+
+    // Non-zero for edge pixels.
+    Edges edges;
+
+    // Filled after hysteresis when CannySettings::edgeList is enabled.
+    // Edges are listed in row-major order, for any thread count.
+    std::optional<CannyEdges> edgeList;
 
-    Phasor<Float> phasor;
-    Matrix matrix;
     Float rangeHigh;
     Float rangeLow;
 
+    Index rows() const
+    {
+        return this->edges.rows();
+    }
+
+    Index cols() const
+    {
+        return this->edges.cols();
+    }
+
+    bool IsEdge(Index row, Index column) const
+    {
+        return this->edges(row, column) != 0;
+    }
+
+    Float GetMagnitude(Index row, Index column) const
+    {
+        return static_cast<Float>(this->magnitude(row, column));
+    }
+
+    Float GetPhase(Index row, Index column) const
+    {
+        return static_cast<Float>(this->phase(row, column));
+    }
+
+    // Collects the edge list from the edge map, for results that were
+    // created without one.
+    CannyEdges ScanEdgeList() const
+    {
+        CannyEdges::CheckSize(this->rows(), this->cols());
+
+        CannyEdges result;
+        result.reserve(
+            static_cast<size_t>((this->edges.array() != 0).count()));
+
+        this->ListEdges(0, this->rows(), result);
+
+        return result;
+    }
+
+    // Appends the edges in rows [firstRow, endRow) in row-major order.
+    void ListEdges(Index firstRow, Index endRow, CannyEdges &edgeList) const
+    {
+        for (Index row = firstRow; row < endRow; ++row)
+        {
+            for (Index column = 0; column < this->cols(); ++column)
+            {
+                if (this->IsEdge(row, column))
+                {
+                    edgeList.PushBack(
+                        row,
+                        column,
+                        this->magnitude(row, column),
+                        this->phase(row, column));
+                }
+            }
+        }
+    }
+
     std::shared_ptr<draw::Pixels> Colorize(const tau::Margins &margins) const
     {
-        auto trimmed = margins.RemoveMargin(this->matrix);
-        tau::HsvPlanes<Float> hsv(trimmed.rows(), trimmed.cols());
+        auto trimmed = margins.RemoveMargin(this->magnitude);
+        tau::HsvPlanes<float> hsv(trimmed.rows(), trimmed.cols());
+
+        auto high = static_cast<float>(this->rangeHigh);
+        auto low = static_cast<float>(this->rangeLow);
 
-        GetSaturation(hsv).array() = Float(1);
+        GetSaturation(hsv).array() = 1.0f;
 
-        GetHue(hsv).array() = Float(120);
+        GetHue(hsv).array() = 120.0f;
 
-        GetHue(hsv).array() = (trimmed.array() < this->rangeHigh)
-            .select(300, GetHue(hsv).array());
+        GetHue(hsv).array() = (trimmed.array() < high)
+            .select(300.0f, GetHue(hsv).array());
 
         GetValue(hsv) =
-            (trimmed.array() >= this->rangeHigh).select(Float(1), trimmed);
+            (trimmed.array() >= high).select(1.0f, trimmed);
 
         GetValue(hsv) =
-            (trimmed.array() >= this->rangeLow
-                && trimmed.array() < this->rangeHigh)
-            .select(Float(0.7), trimmed);
+            (trimmed.array() >= low && trimmed.array() < high)
+            .select(0.7f, trimmed);
 
         auto asRgb = tau::HsvToRgb<uint8_t>(hsv);
 
@@ -65,7 +224,9 @@ class Canny
 {
 public:
     using Result = CannyResult<Float>;
-    using Matrix = typename Result::Matrix;
+
+    // Suppressed magnitudes are stored at the precision of the result.
+    using Matrix = typename Result::Magnitude;
 
     Canny() = default;
 
@@ -162,141 +323,264 @@ public:
         }
     };
 
-    struct Solver
+    // Reads magnitudes and phases from the unscaled gradient on demand.
+    // Non-maximum suppression only needs to compare magnitudes, which is done
+    // with the squared magnitude.
+    template<typename Value>
+    class GradientMagnitude
     {
-        using Directions =
-            Eigen::Matrix<int, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+    public:
+        using Squared =
+            std::conditional_t<std::is_integral_v<Value>, int64_t, Float>;
 
-        Solver()
+        GradientMagnitude(const GradientResult<Value> &gradient)
             :
-            low_(),
-            high_(),
-            depth_(),
-            rows_(),
-            columns_(),
-            suppressed_(),
-            directions_(),
-            result()
+            dx_(gradient.dx),
+            dy_(gradient.dy),
+            maximum_(static_cast<Float>(gradient.maximum)),
+
+            limit_(
+                static_cast<Squared>(gradient.maximum)
+                * static_cast<Squared>(gradient.maximum))
         {
 
         }
 
-        Solver(
-            const CannySettings<Float> &settings,
-            const Matrix &suppressed,
-            const Directions &directions)
+        Eigen::Index rows() const
         {
-            this->Initialize(settings, suppressed, directions);
+            return this->dx_.rows();
         }
 
-        void Initialize(
-            const CannySettings<Float> &settings,
-            const Matrix &suppressed,
-            const Directions &directions)
-        {
-            this->low_ = settings.range.low;
-            this->high_ = settings.range.high;
-            this->depth_ = settings.depth;
-            this->rows_ = suppressed.rows();
-            this->columns_ = suppressed.cols();
-            this->suppressed_ = suppressed;
-            this->directions_ = directions;
-            this->result = Matrix::Zero(this->rows_, this->columns_);
+        Eigen::Index cols() const
+        {
+            return this->dx_.cols();
         }
 
-        // trigger is the point that caused us to check for an extension of the
-        // edge.
-        void Extend(const Point &check, const Point &trigger, size_t depth = 0)
+        // Magnitudes higher than the gradient maximum are clamped.
+        Squared GetSquared(const Point &point) const
         {
-            Float value = this->suppressed_(check.y, check.x);
+            auto dx = static_cast<Squared>(this->dx_(point.y, point.x));
+            auto dy = static_cast<Squared>(this->dy_(point.y, point.x));
 
-            if (value <= this->low_)
-            {
-                return;
-            }
+            return std::min(dx * dx + dy * dy, this->limit_);
+        }
 
-            // This point can be considered on the edge.
-            if (this->result(check.y, check.x) > 0)
-            {
-                // We have been here before.
-                // End the recursion.
-                return;
-            }
+        // Converts a normalized magnitude to a squared threshold.
+        // A squared magnitude is less than or equal to the threshold when
+        // the normalized magnitude is less than or equal to normalized.
+        Squared ToSquared(Float normalized) const
+        {
+            auto scaled = static_cast<double>(normalized)
+                * static_cast<double>(this->maximum_);
 
-            this->result(check.y, check.x) = value;
+            auto squared = scaled * scaled;
 
-            if (depth >= this->depth_)
+            if constexpr (std::is_integral_v<Value>)
             {
-                return;
+                squared = std::floor(squared);
+
+                if (squared >= static_cast<double>(this->limit_))
+                {
+                    return this->limit_;
+                }
             }
 
-            // Check the neighbors along the perpendicular edge.
-            int direction = (this->directions_(check.y, check.x) + 2) % 4;
-            auto neighbors = check.GetNeighbors(direction);
+            return static_cast<Squared>(squared);
+        }
 
-            if (neighbors.first != trigger
-                    && neighbors.first.InBounds(this->rows_, this->columns_))
-            {
-                // Check the first neighbor for inclusion.
-                this->Extend(neighbors.first, check, depth + 1);
-            }
+        // Magnitude scaled to the range 0 to 1.
+        Float GetMagnitude(const Point &point) const
+        {
+            return std::sqrt(static_cast<Float>(this->GetSquared(point)))
+                / this->maximum_;
+        }
 
-            if (neighbors.second != trigger
-                    && neighbors.second.InBounds(this->rows_, this->columns_))
+        // Phase in degrees from 0 to 360.
+        Float GetPhase(const Point &point) const
+        {
+            Float phase = tau::ToDegrees(
+                std::atan2(
+                    static_cast<Float>(this->dy_(point.y, point.x)),
+                    static_cast<Float>(this->dx_(point.y, point.x))));
+
+            if (phase < 0)
             {
-                // Check the second neighbor for inclusion.
-                this->Extend(neighbors.second, check, depth + 1);
+                phase += 360;
             }
+
+            return phase;
         }
 
-    private:
-        Float low_;
-        Float high_;
-        size_t depth_;
-        Eigen::Index rows_;
-        Eigen::Index columns_;
-        Matrix suppressed_;
-        Directions directions_;
+        // Reduces the gradient to one of 4 directions, matching
+        // round(phase / 45) modulo 4, without computing the phase.
+        int GetDirection(const Point &point) const
+        {
+            return QuantizeDirection(
+                this->dx_(point.y, point.x),
+                this->dy_(point.y, point.x));
+        }
 
-    public:
-        Matrix result;
+    private:
+        const tau::MonoImage<Value> &dx_;
+        const tau::MonoImage<Value> &dy_;
+        Float maximum_;
+        Squared limit_;
     };
 
-    static void Solve(
-        Solver &solver,
+    // tan(22.5) and tan(67.5) as Q15 fixed-point ratios.
+    static constexpr int64_t tan22Q15 = 13573;
+    static constexpr int64_t tan67Q15 = 79109;
+    static constexpr int q15Shift = 15;
+
+    // 0: horizontal, 1: diagonal (45 or 225 degrees), 2: vertical,
+    // 3: diagonal (135 or 315 degrees)
+    template<typename Value>
+    static int QuantizeDirection(Value dx, Value dy)
+    {
+        bool isHorizontal;
+        bool isVertical;
+
+        if constexpr (std::is_integral_v<Value>)
+        {
+            int64_t x = std::abs(static_cast<int64_t>(dx));
+            int64_t y = std::abs(static_cast<int64_t>(dy)) << q15Shift;
+
+            isHorizontal = y <= tan22Q15 * x;
+            isVertical = y > tan67Q15 * x;
+        }
+        else
+        {
+            static constexpr auto scale = static_cast<Value>(1 << q15Shift);
+            static constexpr auto tan22 = static_cast<Value>(tan22Q15) / scale;
+            static constexpr auto tan67 = static_cast<Value>(tan67Q15) / scale;
+
+            Value x = std::abs(dx);
+            Value y = std::abs(dy);
+
+            isHorizontal = y <= tan22 * x;
+            isVertical = y > tan67 * x;
+        }
+
+        if (isHorizontal)
+        {
+            return 0;
+        }
+
+        if (isVertical)
+        {
+            return 2;
+        }
+
+        // Matching signs point toward 45 or 225 degrees.
+        return ((dx > 0) == (dy > 0)) ? 1 : 3;
+    }
+
+    using Directions =
+        Eigen::Matrix<uint8_t, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
+    // One flag per pixel, shared by every hysteresis thread.
+    // A pixel belongs to the edge of whichever thread claims it first, and
+    // only that thread writes its value to the result.
+    using Claims = std::vector<std::atomic<uint8_t>>;
+
+    static bool Claim(Claims &claims, Eigen::Index index)
+    {
+        // The claim only has to be atomic. The result is not read until
+        // every thread has been joined.
+        return claims[static_cast<size_t>(index)].exchange(
+            1,
+            std::memory_order_relaxed) == 0;
+    }
+
+    // Seeds edges from the strong pixels in the rows of this chunk, and
+    // follows each edge through weak pixels using an explicit stack.
+    // An edge may be followed into the rows of another chunk. Because every
+    // pixel is claimed exactly once, the union of the threads' work is the
+    // same set of pixels for any thread count.
+    template<typename Value>
+    static void Hysteresis(
         const chunk::Chunk &chunk,
-        const CannySettings<Float> &settings,
-        const Eigen::MatrixX<Float> &suppressed,
-        const Eigen::MatrixX<int> &directions)
+        const GradientMagnitude<Value> &gradient,
+        const Matrix &suppressed,
+        const Directions &directions,
+        Claims &claims,
+        Result &result)
     {
         using Eigen::Index;
-        solver.Initialize(settings, suppressed, directions);
 
+        Index rows = suppressed.rows();
         Index columns = suppressed.cols();
 
-        // Apply strong/weak hysteresis to suppressed result.
+        Float low = result.rangeLow;
+        Float high = result.rangeHigh;
+
+        std::vector<Point> pending;
+
         for (Index row = chunk.index; row < chunk.index + chunk.count; ++row)
         {
             for (Index column = 0; column < columns; ++column)
             {
-                if (suppressed(row, column) < settings.range.high)
+                Float value = suppressed(row, column);
+
+                if (value < high || value <= low)
                 {
                     // Not high enough to trigger edge detection.
                     continue;
                 }
 
+                if (!Claim(claims, row * columns + column))
+                {
+                    // Already part of an edge.
+                    continue;
+                }
+
                 // This pixel is high enough to be considered an edge.
                 // Follow the neighboring pixels as long as they are above the
                 // lower threshold.
-                auto candidate = Point(column, row);
-                solver.Extend(candidate, candidate);
+                pending.emplace_back(column, row);
+
+                while (!pending.empty())
+                {
+                    auto point = pending.back();
+                    pending.pop_back();
+
+                    float magnitude = suppressed(point.y, point.x);
+                    auto phase = static_cast<float>(gradient.GetPhase(point));
+
+                    result.edges(point.y, point.x) = 1;
+                    result.magnitude(point.y, point.x) = magnitude;
+                    result.phase(point.y, point.x) = phase;
+
+                    // Check the neighbors along the perpendicular edge.
+                    int direction = (directions(point.y, point.x) + 2) % 4;
+                    auto neighbors = point.GetNeighbors(direction);
+
+                    for (auto &neighbor: {neighbors.first, neighbors.second})
+                    {
+                        if (!neighbor.InBounds(rows, columns))
+                        {
+                            continue;
+                        }
+
+                        if (suppressed(neighbor.y, neighbor.x) <= low)
+                        {
+                            continue;
+                        }
+
+                        if (Claim(claims, neighbor.y * columns + neighbor.x))
+                        {
+                            pending.push_back(neighbor);
+                        }
+                    }
+                }
             }
         }
     }
 
+    template<typename Value>
     static bool LocateCenterPoint(
         int direction,
-        Phasor<Float> &phasor,
+        const GradientMagnitude<Value> &gradient,
         Matrix &suppressed,
         Point previous,
         Point point,
@@ -305,12 +589,12 @@ public:
         std::deque<Point> similarPoints;
         similarPoints.push_back(point);
 
-        auto previousValue = phasor.GetMagnitude(previous);
-        auto value = phasor.GetMagnitude(point);
-        auto nextValue = phasor.GetMagnitude(next);
+        auto previousValue = gradient.GetSquared(previous);
+        auto value = gradient.GetSquared(point);
+        auto nextValue = gradient.GetSquared(next);
 
-        auto rowCount = phasor.magnitude.rows();
-        auto columnCount = phasor.magnitude.cols();
+        auto rowCount = gradient.rows();
+        auto columnCount = gradient.cols();
 
         // Collect all previous values that match
         while (value == previousValue)
@@ -323,7 +607,7 @@ public:
                 break;
             }
 
-            previousValue = phasor.GetMagnitude(previous);
+            previousValue = gradient.GetSquared(previous);
         }
 
         // Collect all next values that match.
@@ -337,7 +621,7 @@ public:
                 break;
             }
 
-            nextValue = phasor.GetMagnitude(next);
+            nextValue = gradient.GetSquared(next);
         }
 
         // Choose the middle point to pass through the suppression filter.
@@ -353,12 +637,13 @@ public:
         }
         else
         {
-            suppressed(keeper.y, keeper.x) = phasor.GetMagnitude(keeper);
+            suppressed(keeper.y, keeper.x) =
+                static_cast<float>(gradient.GetMagnitude(keeper));
         }
 
         // TODO: Reduce or eliminate repeated calls to this function without
         // degrading the result.
-        // Note: Attempted setting all similarPoints to zero in the phasor
+        // Note: Attempted setting all similarPoints to zero in the gradient
         // magnitude, but that degraded the result and made very little
         // difference to the repeat count.
 
@@ -379,21 +664,25 @@ public:
         result.rangeHigh = this->settings_.range.high;
         result.rangeLow = this->settings_.range.low;
 
-        result.phasor = gradient.template GetPhasor<Float>();
+        GradientMagnitude<Value> magnitude(gradient);
 
-        // Copy the phasor for local modification.
-        auto phasor = result.phasor;
+        Index rows = magnitude.rows();
+        Index columns = magnitude.cols();
 
-        // Reduce the phase to 8 sectors
-        typename Solver::Directions reducedPhase =
-            (phasor.phase.array() / 45).round().template cast<int>();
+        // Thresholds are compared to the squared magnitude, so the square
+        // root is only taken for pixels that survive suppression.
+        auto lowSquared = magnitude.ToSquared(result.rangeLow);
 
-        // 0 and 4 are the same direction,
-        // as are 1 and 5, 2 and 6, and 3 and 7
-        typename Solver::Directions directions = tau::Modulo(reducedPhase, 4);
+        Directions directions(rows, columns);
 
-        Index rows = phasor.magnitude.rows();
-        Index columns = phasor.magnitude.cols();
+        for (Index row = 0; row < rows; ++row)
+        {
+            for (Index column = 0; column < columns; ++column)
+            {
+                directions(row, column) = static_cast<uint8_t>(
+                    magnitude.GetDirection(Point(column, row)));
+            }
+        }
 
         Matrix suppressed = Matrix::Zero(rows, columns);
 
@@ -403,15 +692,15 @@ public:
 
         // Non-maximum Suppression
         // Ignore the 1 pixel border to reduce branching inside the loop.
-        for (Index column = 1; column < columns - 1; ++column)
+        for (Index row = 1; row < rows - 1; ++row)
         {
-            for (Index row = 1; row < rows - 1; ++row)
+            for (Index column = 1; column < columns - 1; ++column)
             {
                 auto point = Point(column, row);
 
-                Float value = phasor.GetMagnitude(point);
+                auto value = magnitude.GetSquared(point);
 
-                if (value <= result.rangeLow)
+                if (value <= lowSquared)
                 {
                     continue;
                 }
@@ -421,12 +710,13 @@ public:
                 auto previous = neighbors.first;
                 auto next = neighbors.second;
 
-                Float previousValue = phasor.GetMagnitude(previous);
-                Float nextValue = phasor.GetMagnitude(next);
+                auto previousValue = magnitude.GetSquared(previous);
+                auto nextValue = magnitude.GetSquared(next);
 
                 if ((value > previousValue) && (value > nextValue))
                 {
-                    suppressed(point.y, point.x) = value;
+                    suppressed(point.y, point.x) =
+                        static_cast<float>(magnitude.GetMagnitude(point));
                 }
                 else if ((value == previousValue) || value == nextValue)
                 {
@@ -434,7 +724,7 @@ public:
                     if (
                         LocateCenterPoint(
                             direction,
-                            phasor,
+                            magnitude,
                             suppressed,
                             previous,
                             point,
@@ -446,7 +736,7 @@ public:
 #else
                     LocateCenterPoint(
                         direction,
-                        phasor,
+                        magnitude,
                         suppressed,
                         previous,
                         point,
@@ -473,9 +763,20 @@ public:
 
         auto chunks = chunk::MakeChunks(this->settings_.threads, rows);
 
+        bool makeEdgeList = this->settings_.edgeList;
+
+        if (makeEdgeList)
+        {
+            CannyEdges::CheckSize(rows, columns);
+        }
+
+        Claims claims(static_cast<size_t>(rows * columns));
+        result.magnitude = Result::Magnitude::Zero(rows, columns);
+        result.phase = Result::Phase::Zero(rows, columns);
+        result.edges = Result::Edges::Zero(rows, columns);
+
         std::vector<jive::Sentry> threadSentries;
         threadSentries.reserve(chunks.size());
-        std::vector<Solver> solvers(chunks.size());
         auto threadPool = jive::GetThreadPool();
 
         for (auto index: jive::Range<size_t>(0, chunks.size()))
@@ -484,28 +785,67 @@ public:
                 threadPool->AddJob(
                     [&, index]()
                     {
-                        Canny<Float>::Solve(
-                            solvers[index],
+                        Canny<Float>::Hysteresis(
                             chunks[index],
-                            this->settings_,
+                            magnitude,
                             suppressed,
-                            directions);
+                            directions,
+                            claims,
+                            result);
                     }));
         }
 
-        result.matrix = Matrix::Zero(rows, columns);
+        for (auto &sentry: threadSentries)
+        {
+            sentry.Wait();
+        }
 
-        for (auto index: jive::Range<size_t>(0, chunks.size()))
+        if (makeEdgeList)
         {
-            threadSentries[index].Wait();
+            // Each thread lists the edges in its rows from the finished edge
+            // map, and the lists are joined in row order, so the order does
+            // not depend on which thread claimed each pixel.
+            std::vector<CannyEdges> edgeLists(chunks.size());
+            threadSentries.clear();
+
+            for (auto index: jive::Range<size_t>(0, chunks.size()))
+            {
+                threadSentries.emplace_back(
+                    threadPool->AddJob(
+                        [&, index]()
+                        {
+                            auto &rowChunk = chunks[index];
+
+                            result.ListEdges(
+                                rowChunk.index,
+                                rowChunk.index + rowChunk.count,
+                                edgeLists[index]);
+                        }));
+            }
+
+            for (auto &sentry: threadSentries)
+            {
+                sentry.Wait();
+            }
 
-            const auto &chunkResult = solvers[index].result;
+            size_t edgeCount = 0;
 
-            // Each thread may have followed an edge into another thread's
-            // boundaries.
-            // Only copy non-zero values.
-            result.matrix =
-                (chunkResult.array() > 0).select(chunkResult, result.matrix);
+            for (auto &edgeList: edgeLists)
+            {
+                edgeCount += edgeList.size();
+            }
+
+            result.edgeList.emplace();
+            result.edgeList->reserve(edgeCount);
+
+            for (auto &edgeList: edgeLists)
+            {
+                result.edgeList->Append(edgeList);
+            }
+        }
+        else
+        {
+            result.edgeList.reset();
         }
 
         return true;
@@ -516,6 +856,9 @@ private:
 };
 
 
+extern template struct CannyResult<float>;
+extern template class Canny<float>;
+
 extern template struct CannyResult<double>;
 extern template class Canny<double>;
 
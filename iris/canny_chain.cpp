@@ -6,7 +6,8 @@ namespace iris
 {
 
 
-std::shared_ptr<draw::Pixels> CannyChainResults::Display(
+template<typename Float>
+std::shared_ptr<draw::Pixels> CannyChainResults<Float>::Display(
     const tau::Margins &margins,
     ThreadsafeColorMap<int32_t> &color) const
 {
@@ -32,7 +33,11 @@ std::shared_ptr<draw::Pixels> CannyChainResults::Display(
 }
 
 
-template class CannyChain<DefaultLevelAdjustNode>;
+template struct CannyChainResults<float>;
+template struct CannyChainResults<double>;
+
+template class CannyChain<float, DefaultLevelAdjustNode>;
+template class CannyChain<double, DefaultLevelAdjustNode>;
 
 
 } // end namespace iris
@@ -14,17 +14,19 @@ namespace iris
 {
 
 
+template<typename Float>
 struct CannyChainFilters
 {
     using GaussianFilter = Gaussian<int32_t, 0>;
     using GradientFilter = Gradient<int32_t>;
-    using CannyFilter = Canny<double>;
+    using CannyFilter = Canny<Float>;
 };
 
 
+template<typename Float>
 struct CannyChainResults
 {
-    using Filters = CannyChainFilters;
+    using Filters = CannyChainFilters<Float>;
     std::shared_ptr<const typename Filters::GaussianFilter::Result> gaussian;
     std::shared_ptr<const typename Filters::GradientFilter::Result> gradient;
     std::shared_ptr<const typename Filters::CannyFilter::Result> canny;
@@ -37,10 +39,10 @@ struct CannyChainResults
 
 
 
-template<typename SourceNode>
+template<typename Float, typename SourceNode>
 struct CannyChainNodes
 {
-    using Filters = CannyChainFilters;
+    using Filters = CannyChainFilters<Float>;
     using GaussianFilter = typename Filters::GaussianFilter;
     using GradientFilter = typename Filters::GradientFilter;
     using CannyFilter = typename Filters::CannyFilter;
@@ -53,7 +55,7 @@ struct CannyChainNodes
     using GradientNode_ = GradientNode<GaussianNode>;
 
     using CannyNode =
-        iris::Node<GradientNode_, CannyFilter, CannyControl<double>>;
+        iris::Node<GradientNode_, CannyFilter, CannyControl<Float>>;
 
     SourceNode & source;
     GaussianNode gaussian;
@@ -62,7 +64,7 @@ struct CannyChainNodes
 
     CannyChainNodes(
         SourceNode &source_,
-        CannyChainControl controls,
+        CannyChainControl<Float> controls,
         CancelControl cancel)
         :
         source(source_),
@@ -75,33 +77,33 @@ struct CannyChainNodes
 };
 
 
-template<typename SourceNode>
+template<typename Float, typename SourceNode>
 class CannyChain
     :
     public NodeBase
         <
             SourceNode,
-            CannyChainControl,
-            typename CannyChainNodes<SourceNode>::Result,
-            CannyChain<SourceNode>
+            CannyChainControl<Float>,
+            typename CannyChainNodes<Float, SourceNode>::Result,
+            CannyChain<Float, SourceNode>
         >
 {
 public:
-    using Result = typename CannyChainNodes<SourceNode>::Result;
+    using Result = typename CannyChainNodes<Float, SourceNode>::Result;
     using ResultPtr = std::shared_ptr<const Result>;
-    using ChainResults = CannyChainResults;
+    using ChainResults = CannyChainResults<Float>;
 
     using Base = NodeBase
         <
             SourceNode,
-            CannyChainControl,
+            CannyChainControl<Float>,
             Result,
-            CannyChain<SourceNode>
+            CannyChain<Float, SourceNode>
         >;
 
     CannyChain(
         SourceNode &sourceNode,
-        CannyChainControl controls,
+        CannyChainControl<Float> controls,
         CancelControl cancel)
         :
         Base("CannyChain", sourceNode, controls, cancel),
@@ -153,12 +155,18 @@ public:
     }
 
 private:
-    CannyChainNodes<SourceNode> nodes_;
+    CannyChainNodes<Float, SourceNode> nodes_;
 };
 
 
-extern template class CannyChain<DefaultLevelAdjustNode>;
-using DefaultCannyChain = CannyChain<DefaultLevelAdjustNode>;
+extern template struct CannyChainResults<float>;
+extern template struct CannyChainResults<double>;
+
+extern template class CannyChain<float, DefaultLevelAdjustNode>;
+extern template class CannyChain<double, DefaultLevelAdjustNode>;
+
+template<typename Float>
+using DefaultCannyChain = CannyChain<Float, DefaultLevelAdjustNode>;
 
 
 } // end namespace iris
@@ -4,6 +4,14 @@
 template struct pex::Group
     <
         iris::CannyChainFields,
-        iris::CannyChainTemplate,
-        iris::CannyChainCustom
+        iris::CannyChainTemplate<float>::template Template,
+        iris::CannyChainCustom<float>
+    >;
+
+
+template struct pex::Group
+    <
+        iris::CannyChainFields,
+        iris::CannyChainTemplate<double>::template Template,
+        iris::CannyChainCustom<double>
     >;
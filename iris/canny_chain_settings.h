@@ -60,19 +60,24 @@ struct CannyChainFields
 };
 
 
-template<template<typename> typename T>
+template<typename Float>
 struct CannyChainTemplate
 {
-    T<bool> enable;
-    T<GaussianGroup<int32_t>> gaussian;
-    T<GradientGroup<int32_t>> gradient;
-    T<CannyGroup<double>> canny;
+    template<template<typename> typename T>
+    struct Template
+    {
+        T<bool> enable;
+        T<GaussianGroup<int32_t>> gaussian;
+        T<GradientGroup<int32_t>> gradient;
+        T<CannyGroup<Float>> canny;
 
-    static constexpr auto fields = CannyChainFields<CannyChainTemplate>::fields;
-    static constexpr auto fieldsTypeName = "CannyChain";
+        static constexpr auto fields = CannyChainFields<Template>::fields;
+        static constexpr auto fieldsTypeName = "CannyChain";
+    };
 };
 
 
+template<typename Float>
 struct CannyChainCustom
 {
     template<typename PlainBase>
@@ -84,7 +89,7 @@ struct CannyChainCustom
                 true,
                 GaussianSettings<int32_t>{},
                 GradientSettings<int32_t>{},
-                CannySettings<double>{}}
+                CannySettings<Float>{}}
         {
             this->gaussian.sigma = 2.0;
         }
@@ -124,20 +129,29 @@ struct CannyChainCustom
 };
 
 
+template<typename Float>
 using CannyChainGroup = pex::Group
     <
         CannyChainFields,
-        CannyChainTemplate,
-        CannyChainCustom
+        CannyChainTemplate<Float>::template Template,
+        CannyChainCustom<Float>
     >;
 
-using CannyChainSettings = typename CannyChainGroup::Plain;
-using CannyChainControl = typename CannyChainGroup::DefaultControl;
-using CannyChainModel = typename CannyChainGroup::Model;
+template<typename Float>
+using CannyChainSettings = typename CannyChainGroup<Float>::Plain;
+
+template<typename Float>
+using CannyChainControl = typename CannyChainGroup<Float>::DefaultControl;
+
+template<typename Float>
+using CannyChainModel = typename CannyChainGroup<Float>::Model;
+
 
+DECLARE_OUTPUT_STREAM_OPERATOR(CannyChainSettings<float>)
+DECLARE_EQUALITY_OPERATORS(CannyChainSettings<float>)
 
-DECLARE_OUTPUT_STREAM_OPERATOR(CannyChainSettings)
-DECLARE_EQUALITY_OPERATORS(CannyChainSettings)
+DECLARE_OUTPUT_STREAM_OPERATOR(CannyChainSettings<double>)
+DECLARE_EQUALITY_OPERATORS(CannyChainSettings<double>)
 
 
 } // end namespace iris
@@ -146,6 +160,14 @@ DECLARE_EQUALITY_OPERATORS(CannyChainSettings)
 extern template struct pex::Group
     <
         iris::CannyChainFields,
-        iris::CannyChainTemplate,
-        iris::CannyChainCustom
+        iris::CannyChainTemplate<float>::template Template,
+        iris::CannyChainCustom<float>
+    >;
+
+
+extern template struct pex::Group
+    <
+        iris::CannyChainFields,
+        iris::CannyChainTemplate<double>::template Template,
+        iris::CannyChainCustom<double>
     >;
@@ -17,7 +17,7 @@ struct CannyFields
     static constexpr auto fields = std::make_tuple(
         fields::Field(&T::enable, "enable"),
         fields::Field(&T::range, "range"),
-        fields::Field(&T::depth, "depth"),
+        fields::Field(&T::edgeList, "edgeList"),
         fields::Field(&T::threads, "threads"));
 
     static constexpr auto fieldsTypeName = "Canny";
@@ -50,7 +50,7 @@ struct CannyTemplate
     {
         T<bool> enable;
         T<typename CannyRanges<Float>::Group> range;
-        T<size_t> depth;
+        T<bool> edgeList;
         T<size_t> threads;
 
         static constexpr auto fields = CannyFields<Template>::fields;
@@ -62,7 +62,6 @@ template<typename Float>
 struct CannySettings:
     public CannyTemplate<Float>::template Template<pex::Identity>
 {
-    static constexpr size_t defaultDepth = 32;
     static constexpr size_t defaultThreads = 4;
 
     CannySettings()
@@ -70,7 +69,7 @@ struct CannySettings:
         CannyTemplate<Float>::template Template<pex::Identity>{
             true,
             typename CannyRanges<Float>::Settings{},
-            defaultDepth,
+            true,
             defaultThreads}
     {
 
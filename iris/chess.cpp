@@ -25,12 +25,12 @@ bool Chess::Filter(const ChessInput &input, ChessSolution &result)
         return false;
     }
 
-    if (input.hough.lines.empty())
+    if (input.lines.empty())
     {
         return false;
     }
 
-    result = ChessOutput(input.hough.lines, input.vertices, this->settings_);
+    result = ChessOutput(input.lines, input.vertices, this->settings_);
 
     return true;
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <tau/eigen.h>
 #include <tau/vector2d.h>
 #include <tau/line2d.h>
@@ -17,12 +18,34 @@ namespace iris
 {
 
 
+// Chess works on double lines, so the lines from either precision of Hough
+// are converted once here.
 struct ChessInput
 {
-    using Lines = typename HoughResult<double>::Lines;
+    using Lines = std::vector<tau::Line2d<double>>;
 
-    Vertices vertices;
-    HoughResult<double> hough;
+    template<typename Float>
+    ChessInput(
+        const VertexSet &vertices_,
+        const HoughResult<Float, uint32_t> &hough)
+        :
+        vertices(vertices_),
+        lines()
+    {
+        this->lines.reserve(hough.lines.size());
+
+        for (auto &line: hough.lines)
+        {
+            this->lines.emplace_back(
+                line.point.template Cast<double>(),
+                tau::Vector2d<double>(
+                    static_cast<double>(line.vector.x),
+                    static_cast<double>(line.vector.y)));
+        }
+    }
+
+    VertexSet vertices;
+    Lines lines;
 };
 
 
@@ -28,7 +28,7 @@ namespace iris
 
 ChessOutput::ChessOutput(
     const LineCollection &lines_,
-    const Vertices &vertices_,
+    const VertexSet &vertices_,
     const ChessSettings &settings)
     :
     lines(lines_),
@@ -59,18 +59,18 @@ ChessOutput::ChessOutput(
 
     LOG_GROUPS
 
-    this->groups = SplitGroupsOnSpacing(
+    SplitGroupsOnSpacing(
         this->groups,
         settings.maximumSpacing,
         settings.minimumSpacing);
 
     LOG_GROUPS
 
-    this->groups = FilterByAngle(this->groups);
+    FilterByAngle(this->groups);
 
     LOG_GROUPS
 
-    this->groups = SplitMissingLines(this->groups, settings.ratioLimit);
+    SplitMissingLines(this->groups, settings.ratioLimit);
 
     LOG_GROUPS
 
@@ -108,7 +108,7 @@ ChessOutput::ChessOutput(
 
 NamedVertices FormVertices(
     const AxisGroups &axisGroups,
-    const Vertices &vertices,
+    const VertexSet &vertices,
     double maximumVertexDistance)
 {
     using Line = typename ChessOutput::Line;
@@ -119,13 +119,14 @@ NamedVertices FormVertices(
     }
 
     auto result = NamedVertices{};
+    VertexIndex vertexIndex(vertices, maximumVertexDistance);
 
     size_t verticalCount = axisGroups.vertical.lines.size();
     size_t horizontalCount = axisGroups.horizontal.lines.size();
 
     // Iterate over the vertices of horizontal and vertical lines.
     // If an intersection has a vertex within the maximumVertexDistance
-    // threshold, consider that point a vertex on the chess board.
+    // threshold, consider the nearest one a vertex on the chess board.
     for (auto j: jive::Range<size_t>(0, horizontalCount))
     {
         const Line &horizontalLine = axisGroups.horizontal.lines[j];
@@ -137,15 +138,14 @@ NamedVertices FormVertices(
             auto vertex = verticalLine.Intersect(horizontalLine);
             auto logicalColumn = axisGroups.vertical.GetLogicalIndex(i);
 
-            auto vertexPoint = FindVertex(
-                vertex,
-                vertices,
-                maximumVertexDistance);
+            auto found = vertexIndex.FindVertex(vertex);
 
-            if (vertexPoint)
+            if (found)
             {
                 result.push_back(
-                    {{logicalColumn, logicalRow}, vertexPoint->point});
+                    {
+                        {logicalColumn, logicalRow},
+                        vertices.GetPoint(*found)});
             }
         }
     }
@@ -23,7 +23,7 @@ struct ChessOutput
 
     ChessOutput(
         const LineCollection &lines_,
-        const Vertices &vertices_,
+        const VertexSet &vertices_,
         const ChessSettings &settings);
 
     LineCollection lines;
@@ -36,7 +36,7 @@ struct ChessOutput
 
 NamedVertices FormVertices(
     const AxisGroups &axisGroups,
-    const Vertices &vertices,
+    const VertexSet &vertices,
     double maximumVertexDistance);
 
 
@@ -1,32 +1,169 @@
 #include "iris/chess/find_vertex.h"
+#include <algorithm>
+#include <cmath>
+#include <iterator>
 
 
 namespace iris
 {
 
 
-// Return the first vertex that is within the maximum distance.
-std::optional<Vertex> FindVertex(
-    const tau::Point2d<double> &candidate,
-    const Vertices &vertices,
-    double maximumDistance)
+VertexIndex::VertexIndex(const VertexSet &vertices, double maximumDistance)
+    :
+    vertices_(vertices),
+    maximumSquared_(maximumDistance * maximumDistance),
+    left_(0.0),
+    top_(0.0),
+    cellSize_(1.0),
+    cellColumns_(0),
+    cellRows_(0),
+    offsets_(),
+    members_()
 {
     if (vertices.empty())
     {
-        throw std::logic_error("must have vertices");
+        return;
     }
 
-    for (const auto &vertex: vertices)
+    auto [left, right] =
+        std::minmax_element(std::begin(vertices.x), std::end(vertices.x));
+
+    auto [top, bottom] =
+        std::minmax_element(std::begin(vertices.y), std::end(vertices.y));
+
+    this->left_ = *left;
+    this->top_ = *top;
+
+    double extent = std::max(*right - *left, *bottom - *top);
+
+    // About as many cells as vertices keeps the index O(N) in time and
+    // memory, however sparse the vertices are relative to the maximum
+    // distance.
+    auto cellsPerSide =
+        std::ceil(std::sqrt(static_cast<double>(vertices.size())));
+
+    this->cellSize_ = std::max(
+        {maximumDistance, extent / cellsPerSide, 1e-9});
+
+    auto getCount = [this](double distance)
+    {
+        return static_cast<size_t>(std::floor(distance / this->cellSize_)) + 1;
+    };
+
+    this->cellColumns_ = getCount(*right - *left);
+    this->cellRows_ = getCount(*bottom - *top);
+
+    // Counting sort of the vertices by cell.
+    auto cellCount = this->cellColumns_ * this->cellRows_;
+    this->offsets_.assign(cellCount + 1, 0);
+
+    std::vector<size_t> cells(vertices.size());
+
+    for (size_t index = 0; index < vertices.size(); ++index)
+    {
+        cells[index] = this->GetCell_(vertices.x[index], vertices.y[index]);
+        ++this->offsets_[cells[index] + 1];
+    }
+
+    for (size_t cell = 1; cell <= cellCount; ++cell)
+    {
+        this->offsets_[cell] += this->offsets_[cell - 1];
+    }
+
+    this->members_.resize(vertices.size());
+
+    std::vector<size_t> next(
+        std::begin(this->offsets_),
+        std::prev(std::end(this->offsets_)));
+
+    for (size_t index = 0; index < vertices.size(); ++index)
     {
-        auto distance = candidate.Distance(vertex.point);
+        this->members_[next[cells[index]]++] = index;
+    }
+}
 
-        if (distance < maximumDistance)
+
+std::optional<size_t> VertexIndex::FindVertex(
+    const tau::Point2d<double> &candidate) const
+{
+    if (this->offsets_.empty())
+    {
+        return {};
+    }
+
+    auto cellColumn = std::floor((candidate.x - this->left_) / this->cellSize_);
+    auto cellRow = std::floor((candidate.y - this->top_) / this->cellSize_);
+
+    auto columns = static_cast<double>(this->cellColumns_);
+    auto rows = static_cast<double>(this->cellRows_);
+
+    // Every vertex within the maximum distance is at most one cell away.
+    if (cellColumn < -1.0 || cellColumn > columns
+        || cellRow < -1.0 || cellRow > rows)
+    {
+        return {};
+    }
+
+    auto first = [](double cell)
+    {
+        return static_cast<size_t>(std::max(0.0, cell - 1));
+    };
+
+    auto last = [](double cell, double count)
+    {
+        return static_cast<size_t>(std::min(count - 1, cell + 1));
+    };
+
+    auto firstColumn = first(cellColumn);
+    auto lastColumn = last(cellColumn, columns);
+    auto firstRow = first(cellRow);
+    auto lastRow = last(cellRow, rows);
+
+    std::optional<size_t> result;
+
+    // Compare squared distances to avoid sqrt.
+    double nearest = this->maximumSquared_;
+
+    for (size_t row = firstRow; row <= lastRow; ++row)
+    {
+        for (size_t column = firstColumn; column <= lastColumn; ++column)
         {
-            return {vertex};
+            auto cell = row * this->cellColumns_ + column;
+
+            for (
+                auto member = this->offsets_[cell];
+                member < this->offsets_[cell + 1];
+                ++member)
+            {
+                auto index = this->members_[member];
+                double x = this->vertices_.x[index] - candidate.x;
+                double y = this->vertices_.y[index] - candidate.y;
+                double squared = x * x + y * y;
+
+                // Ties go to the earlier vertex.
+                if (squared < nearest
+                    || (squared == nearest && result && index < *result))
+                {
+                    nearest = squared;
+                    result = index;
+                }
+            }
         }
     }
 
-    return {};
+    return result;
+}
+
+
+size_t VertexIndex::GetCell_(double x, double y) const
+{
+    auto column = static_cast<size_t>(
+        std::floor((x - this->left_) / this->cellSize_));
+
+    auto row = static_cast<size_t>(
+        std::floor((y - this->top_) / this->cellSize_));
+
+    return row * this->cellColumns_ + column;
 }
 
 
@@ -3,17 +3,46 @@
 
 #include "iris/vertex.h"
 #include <optional>
+#include <vector>
 
 
 namespace iris
 {
 
 
-// Return the first vertex that is within the maximum distance.
-std::optional<Vertex> FindVertex(
-    const tau::Point2d<double> &candidate,
-    const Vertices &vertices,
-    double maximumDistance);
+/*
+ * Finds the nearest vertex to a point.
+ *
+ * The vertices are sorted into a grid of cells at least as wide as the
+ * maximum distance, so a query only visits the nine cells about the point.
+ */
+class VertexIndex
+{
+public:
+    VertexIndex(const VertexSet &vertices, double maximumDistance);
+
+    // Return the index of the nearest vertex that is within the maximum
+    // distance.
+    std::optional<size_t> FindVertex(
+        const tau::Point2d<double> &candidate) const;
+
+private:
+    // The cell of a point within the bounds of the vertices.
+    size_t GetCell_(double x, double y) const;
+
+    const VertexSet &vertices_;
+    double maximumSquared_;
+    double left_;
+    double top_;
+    double cellSize_;
+    size_t cellColumns_;
+    size_t cellRows_;
+
+    // members_[offsets_[cell]] to members_[offsets_[cell + 1] - 1] are the
+    // indices of the vertices in cell.
+    std::vector<size_t> offsets_;
+    std::vector<size_t> members_;
+};
 
 
 } // end namespace iris
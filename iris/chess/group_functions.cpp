@@ -1,5 +1,7 @@
 #include "iris/chess/group_functions.h"
+#include <algorithm>
 #include <cstddef>
+#include <iterator>
 
 
 namespace iris
@@ -60,21 +62,18 @@ void AddLineToGroups(
 }
 
 
-Groups FilterByAngle(const Groups &groups)
+void FilterByAngle(Groups &groups)
 {
-    Groups result;
-
     for (auto &group: groups)
     {
-        auto localGroup = group;
-        localGroup.RemoveOutlierLines();
+        group.RemoveOutlierLines();
 
-        if (localGroup.lines.empty())
+        if (group.lines.empty())
         {
             continue;
         }
 
-        auto angles = localGroup.GetAngles();
+        auto angles = group.GetAngles();
         auto quartiles = tau::GetAngularQuartiles(angles);
 
         CHESS_LOG("Angular quartiles: ", quartiles);
@@ -102,78 +101,88 @@ Groups FilterByAngle(const Groups &groups)
                     return tau::LineAngleDifference(first, second) >= 0.0;
                 });
 
-            if (isAscending || isDescending)
+            if (!isAscending && !isDescending)
             {
-                result.push_back(localGroup);
+                group = group.FilterOnSorting();
             }
-            else
-            {
-                result.push_back(localGroup.FilterOnSorting());
-            }
-        }
-        else
-        {
-            // Interquartile range is <= 3
-            // Lines are nearly parallel.
-            result.push_back(localGroup);
         }
+
+        // Otherwise the interquartile range is <= 3, and the lines are
+        // nearly parallel.
     }
 
-    return result;
+    groups.erase(
+        std::remove_if(
+            begin(groups),
+            end(groups),
+            [](const LineGroup &group) -> bool
+            {
+                return group.lines.empty();
+            }),
+        end(groups));
 }
 
 
-Groups SplitGroupsOnAngles(const Groups &groups)
+// Replaces each group with the groups it splits into.
+// The splits are collected from the last group to the first, so the groups
+// come out in the same order as when each split was prepended to the result.
+template<typename Split>
+void SplitGroups(Groups &groups, const Split &split)
 {
-    Groups splitOnAngles;
+    Groups result;
+    result.reserve(groups.size());
 
-    for (auto &group: groups)
+    for (auto group = groups.rbegin(); group != groups.rend(); ++group)
     {
-        auto split = group.SplitOnAngles();
-        splitOnAngles.insert(begin(splitOnAngles), begin(split), end(split));
+        auto splitGroups = split(*group);
+
+        std::move(
+            begin(splitGroups),
+            end(splitGroups),
+            std::back_inserter(result));
     }
 
-    return splitOnAngles;
+    groups.swap(result);
+}
+
+
+void SplitGroupsOnAngles(Groups &groups)
+{
+    SplitGroups(
+        groups,
+        [](LineGroup &group)
+        {
+            return group.SplitOnAngles();
+        });
 }
 
 
 // Split the groups if there are any gaps larger than spacing limit.
-Groups SplitGroupsOnSpacing(
-    const Groups &groups,
+void SplitGroupsOnSpacing(
+    Groups &groups,
     double maximumSpacing,
     double minimumSpacing)
 {
-    Groups splitOnSpacing;
-    auto localGroups = groups;
-
-    for (auto &group: localGroups)
-    {
-        // For this pass, we are not concerned with the orientation of the
-        // sort, only that they are consistently sorted.
-        group.SortByPosition(false);
-        auto split = group.SplitOnSpacing(maximumSpacing, minimumSpacing);
-        splitOnSpacing.insert(begin(splitOnSpacing), begin(split), end(split));
-    }
-
-    return splitOnSpacing;
+    SplitGroups(
+        groups,
+        [&](LineGroup &group)
+        {
+            // For this pass, we are not concerned with the orientation of
+            // the sort, only that they are consistently sorted.
+            group.SortByPosition(false);
+            return group.SplitOnSpacing(maximumSpacing, minimumSpacing);
+        });
 }
 
 
-Groups SplitMissingLines(const Groups &groups, double ratioLimit)
+void SplitMissingLines(Groups &groups, double ratioLimit)
 {
-    Groups splitOnMissingLines;
-
-    for (auto &group: groups)
-    {
-        auto split = group.SplitOnMissingLines(ratioLimit);
-
-        splitOnMissingLines.insert(
-            begin(splitOnMissingLines),
-            begin(split),
-            end(split));
-    }
-
-    return splitOnMissingLines;
+    SplitGroups(
+        groups,
+        [&](LineGroup &group)
+        {
+            return group.SplitOnMissingLines(ratioLimit);
+        });
 }
 
 
@@ -212,7 +221,9 @@ void SortDescending(
 {
     // Sort descending by number of lines and by how close the angle is to
     // 90 from the vertical
-    groups.sort(
+    std::stable_sort(
+        begin(groups),
+        end(groups),
         [&](const LineGroup &first, const LineGroup &second) -> bool
         {
             auto sizeDifference = std::abs(
@@ -259,14 +270,7 @@ void CombineFirstAndLast(Groups &groups, double groupSeparation_deg)
                 groupSeparation_deg))
         {
             // Combine the groups.
-            for (auto &line: back.lines)
-            {
-                front.lines.push_back(line);
-            }
-
-            front.angle =
-                tau::ToDegrees(
-                    tau::GetAverageAngleRadians<double>(front.lines));
+            front.Combine(back);
 
             // Remove back.
             groups.pop_back();
@@ -288,7 +292,9 @@ AxisGroups SelectAxisGroups(
     AxisGroups result;
 
     // Sort descending by number of lines.
-    groups.sort(
+    std::stable_sort(
+        begin(groups),
+        end(groups),
         [](const LineGroup &first, const LineGroup &second) -> bool
         {
             return first.lines.size() > second.lines.size();
@@ -16,20 +16,20 @@ void AddLineToGroups(
     double groupSeparation_deg);
 
 
-Groups FilterByAngle(const Groups &groups);
+void FilterByAngle(Groups &groups);
 
 
-Groups SplitGroupsOnAngles(const Groups &groups);
+void SplitGroupsOnAngles(Groups &groups);
 
 
 // Split the groups if there are any gaps larger than spacing limit.
-Groups SplitGroupsOnSpacing(
-    const Groups &groups,
+void SplitGroupsOnSpacing(
+    Groups &groups,
     double maximumSpacing,
     double minimumSpacing);
 
 
-Groups SplitMissingLines(const Groups &groups, double ratioLimit);
+void SplitMissingLines(Groups &groups, double ratioLimit);
 
 
 void RemoveOutlierGroups(
@@ -1,7 +1,7 @@
 #pragma once
 
 
-#include <list>
+#include <vector>
 #include "iris/chess/line_group.h"
 
 
@@ -9,7 +9,7 @@ namespace iris
 {
 
 
-using Groups = std::list<LineGroup>;
+using Groups = std::vector<LineGroup>;
 
 
 } // end namespace iris
@@ -11,7 +11,9 @@ using Line = typename LineGroup::Line;
 LineGroup::LineGroup()
     :
     angle{},
-    lines{}
+    lines{},
+    sinSum_{},
+    cosSum_{}
 {
 
 }
@@ -20,18 +22,20 @@ LineGroup::LineGroup()
 LineGroup::LineGroup(const Line &line)
     :
     angle(line.GetAngleDegrees()),
-    lines({line})
+    lines({line}),
+    sinSum_{},
+    cosSum_{}
 {
-
+    this->Accumulate_(line);
 }
 
 
 LineGroup & LineGroup::Combine(const LineGroup &other)
 {
     this->lines.insert(end(this->lines), begin(other.lines), end(other.lines));
-
-    this->angle = tau::ToDegrees(
-        tau::GetAverageAngleRadians<double>(this->lines));
+    this->sinSum_ += other.sinSum_;
+    this->cosSum_ += other.cosSum_;
+    this->UpdateAngle_();
 
     return *this;
 }
@@ -40,9 +44,8 @@ LineGroup & LineGroup::Combine(const LineGroup &other)
 void LineGroup::AddLine(const Line &line)
 {
     this->lines.push_back(line);
-
-    this->angle = tau::ToDegrees(
-        tau::GetAverageAngleRadians<double>(this->lines));
+    this->Accumulate_(line);
+    this->UpdateAngle_();
 }
 
 
@@ -159,6 +162,10 @@ void LineGroup::RemoveOutlierLines()
 
     this->lines.erase(result, this->lines.end());
 
+    // The mean angle is left as it was, but later additions are averaged
+    // with the remaining lines only.
+    this->ResetSums_();
+
     CHESS_LOG("lines.size(): ", this->lines.size());
 }
 
@@ -660,32 +667,56 @@ void LineGroup::SortByPosition(bool isHorizontal)
 }
 
 
-std::ostream & operator<<(
-    std::ostream &outputStream,
-    const LineGroup &group)
+void LineGroup::Accumulate_(const Line &line)
 {
-    return group.ToStream(outputStream);
+    // Lines are undirected, so the angles are doubled to make 0 and 180
+    // degrees the same direction.
+    double doubled = 2.0 * tau::ToRadians(line.GetAngleDegrees());
+    this->sinSum_ += std::sin(doubled);
+    this->cosSum_ += std::cos(doubled);
 }
 
 
-std::ostream & operator<<(
-    std::ostream &outputStream,
-    const std::list<LineGroup> &groups)
+void LineGroup::ResetSums_()
 {
-    size_t count = 0;
+    this->sinSum_ = 0.0;
+    this->cosSum_ = 0.0;
 
-    for (auto &group: groups)
+    for (auto &line: this->lines)
     {
-        outputStream << ++count << ": " << group << std::endl;
+        this->Accumulate_(line);
     }
+}
 
-    return outputStream;
+
+void LineGroup::UpdateAngle_()
+{
+    if (this->lines.empty())
+    {
+        return;
+    }
+
+    this->angle =
+        tau::ToDegrees(std::atan2(this->sinSum_, this->cosSum_)) / 2.0;
+
+    if (this->angle < 0.0)
+    {
+        this->angle += 180.0;
+    }
+}
+
+
+std::ostream & operator<<(
+    std::ostream &outputStream,
+    const LineGroup &group)
+{
+    return group.ToStream(outputStream);
 }
 
 
 std::ostream & operator<<(
     std::ostream &outputStream,
-    const std::vector<LineGroup> groups)
+    const std::vector<LineGroup> &groups)
 {
     size_t count = 0;
 
@@ -1,7 +1,6 @@
 #pragma once
 
 
-#include <list>
 #include <vector>
 #include <iostream>
 #include <tau/vector2d.h>
@@ -67,22 +66,29 @@ struct LineGroup
         bool allowSkippedLines);
 
     void SortByPosition(bool isHorizontal);
-};
 
+private:
+    void Accumulate_(const Line &line);
 
-std::ostream & operator<<(
-    std::ostream &outputStream,
-    const LineGroup &group);
+    void ResetSums_();
+
+    void UpdateAngle_();
+
+    // Running sums of the doubled line angles, so that adding a line updates
+    // the mean angle without revisiting the others.
+    double sinSum_;
+    double cosSum_;
+};
 
 
 std::ostream & operator<<(
     std::ostream &outputStream,
-    const std::list<LineGroup> &groups);
+    const LineGroup &group);
 
 
 std::ostream & operator<<(
     std::ostream &outputStream,
-    const std::vector<LineGroup> groups);
+    const std::vector<LineGroup> &groups);
 
 
 } // end namespace iris
@@ -5,9 +5,10 @@ namespace iris
 {
 
 
-ChessChainNodes::ChessChainNodes(
+template<typename Float>
+ChessChainNodes<Float>::ChessChainNodes(
     SourceNode &source,
-    const ChessChainControl &control,
+    const ChessChainControl<Float> &control,
     const CancelControl &cancel)
     :
     mask("Mask", source, control.mask, cancel),
@@ -26,18 +27,27 @@ ChessChainNodes::ChessChainNodes(
 
     canny("Canny", this->gradientForCanny, control.canny, cancel),
     hough("Hough", this->canny, control.hough, cancel),
-    harris("Harris", this->gradientForHarris, control.harris, cancel),
+    harris(this->gradientForHarris, this->hough, control, cancel),
     vertices("Vertices", this->harris, control.vertices, cancel),
-    mix(this->vertices, this->hough, cancel),
+    saddle("Saddle", this->level, control.saddle, cancel),
+
+    chessVertices(
+        this->vertices,
+        this->saddle,
+        control.useSaddle,
+        cancel),
+
+    mix(this->chessVertices, this->hough, cancel),
     chess("chess", this->mix, control.chess, cancel)
 {
     PEX_NAME("ChessChainNodes");
 }
 
 
-ChessChain::ChessChain(
+template<typename Float>
+ChessChain<Float>::ChessChain(
     SourceNode &sourceNode,
-    const ChessChainControl &control,
+    const ChessChainControl<Float> &control,
     const CancelControl &cancel)
     :
     Base("ChessChain", sourceNode, control, cancel),
@@ -48,22 +58,112 @@ ChessChain::ChessChain(
     autoDetectEndpoint_(
         PEX_THIS("ChessChain"),
         control.autoDetectSettings,
-        &ChessChain::AutoDetectSettings)
+        &ChessChain::AutoDetectSettings),
+    trackerMutex_(),
+
+    tracker_(
+        this->settings_.tracker,
+        this->settings_.harris,
+        this->settings_.vertices),
+
+    isTracked_(false)
 {
 
 }
 
-ChessChain::ResultPtr ChessChain::DoGetResult()
+template<typename Float>
+void ChessChain<Float>::SettingsChanged(const Settings &settings)
+{
+    // Any change may invalidate the tracked board, so the next frame begins
+    // with a full detection.
+    std::lock_guard lock(this->trackerMutex_);
+
+    this->tracker_ = ChessTracker<Float>(
+        settings.tracker,
+        settings.harris,
+        settings.vertices);
+}
+
+template<typename Float>
+typename ChessChain<Float>::ResultPtr ChessChain<Float>::DoGetResult()
 {
     if (!this->settings_.enable)
     {
         return {};
     }
 
-    return this->nodes_.chess.GetResult();
+    {
+        std::lock_guard lock(this->trackerMutex_);
+        this->isTracked_ = false;
+    }
+
+    if (!this->settings_.tracker.enable)
+    {
+        return this->nodes_.chess.GetResult();
+    }
+
+    auto tracked = this->Track_();
+
+    if (tracked)
+    {
+        return tracked;
+    }
+
+    auto result = this->nodes_.chess.GetResult();
+
+    if (result)
+    {
+        std::lock_guard lock(this->trackerMutex_);
+        this->tracker_.SetKeyframe(*result);
+    }
+
+    return result;
+}
+
+template<typename Float>
+typename ChessChain<Float>::ResultPtr ChessChain<Float>::Track_()
+{
+    {
+        std::lock_guard lock(this->trackerMutex_);
+
+        if (this->tracker_.NeedsKeyframe())
+        {
+            return {};
+        }
+    }
+
+    // Only the gradient is needed to track, so Canny and Hough do not run.
+    auto gradient = this->nodes_.gradientForHarris.GetResult();
+
+    if (!gradient)
+    {
+        return {};
+    }
+
+    auto result = std::make_shared<ChessSolution>();
+
+    std::lock_guard lock(this->trackerMutex_);
+
+    if (!this->tracker_.Track(*gradient, *result))
+    {
+        return {};
+    }
+
+    this->isTracked_ = true;
+
+    return result;
 }
 
-std::shared_ptr<ChessChain::ChainResults> ChessChain::GetChainResults()
+template<typename Float>
+void ChessChain<Float>::SetKeyframe(const ChessSolution &solution)
+{
+    std::lock_guard lock(this->trackerMutex_);
+    this->tracker_.SetKeyframe(solution);
+}
+
+template<typename Float>
+std::shared_ptr<typename ChessChain<Float>::ChainResults>
+ChessChain<Float>::GetChainResults()
 {
     if (!this->settings_.enable)
     {
@@ -80,11 +180,36 @@ std::shared_ptr<ChessChain::ChainResults> ChessChain::GetChainResults()
         this->linesShapesId_.Get(),
         this->verticesShapesId_.Get());
 
-    result->chess = this->nodes_.chess.GetResult();
-    result->vertices = this->nodes_.vertices.GetResult();
-    result->harris = this->nodes_.harris.GetResult();
-    result->hough = this->nodes_.hough.GetResult();
-    result->canny = this->nodes_.canny.GetResult();
+    result->chess = this->GetResult();
+
+    bool isTracked;
+
+    {
+        std::lock_guard lock(this->trackerMutex_);
+        isTracked = this->isTracked_;
+    }
+
+    result->isTracked = isTracked;
+
+    // Requesting these results would run the detection that tracking skips.
+    if (!isTracked)
+    {
+        result->vertices = this->nodes_.chessVertices.GetResult();
+
+        // Only the selected source of vertices is computed.
+        if (this->nodes_.chessVertices.UseSaddle())
+        {
+            result->saddle = this->nodes_.saddle.GetResult();
+        }
+        else
+        {
+            result->harris = this->nodes_.harris.GetResult();
+        }
+
+        result->hough = this->nodes_.hough.GetResult();
+        result->canny = this->nodes_.canny.GetResult();
+    }
+
     result->gradient = this->nodes_.gradientForHarris.GetResult();
     result->gaussian = this->nodes_.gaussian.GetResult();
     result->level = this->nodes_.level.GetResult();
@@ -101,7 +226,8 @@ std::shared_ptr<ChessChain::ChainResults> ChessChain::GetChainResults()
 }
 
 
-void ChessChain::AutoDetectSettings()
+template<typename Float>
+void ChessChain<Float>::AutoDetectSettings()
 {
     this->nodes_.level.AutoDetectSettings();
     this->nodes_.gradientForCanny.AutoDetectSettings();
@@ -109,4 +235,11 @@ void ChessChain::AutoDetectSettings()
 }
 
 
+template struct ChessChainNodes<float>;
+template struct ChessChainNodes<double>;
+
+template class ChessChain<float>;
+template class ChessChain<double>;
+
+
 } // end namespace iris
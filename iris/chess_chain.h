@@ -2,9 +2,11 @@
 
 
 #include <cstdint>
+#include <mutex>
 #include <pex/endpoint.h>
 #include "iris/chess_chain_results.h"
 #include "iris/chess_chain_settings.h"
+#include "iris/chess_tracker.h"
 #include "iris/chess/chess_solution.h"
 
 
@@ -20,11 +22,255 @@ struct ChessNodes
 };
 
 
+/*
+ * Evaluates Harris over the whole gradient, or, when sparseHarris is set,
+ * only near the intersections of the Hough lines.
+ *
+ * The node follows the settings of the whole chain, because a sparse
+ * response also depends on the settings of the lines.
+ */
+template<typename Float, typename GradientSource, typename LinesSource>
+class ChessHarrisNode
+    :
+    public NodeBase
+        <
+            GradientSource,
+            ChessChainControl<Float>,
+            HarrisResult<Float>,
+            ChessHarrisNode<Float, GradientSource, LinesSource>
+        >
+{
+public:
+    using Base = NodeBase
+        <
+            GradientSource,
+            ChessChainControl<Float>,
+            HarrisResult<Float>,
+            ChessHarrisNode<Float, GradientSource, LinesSource>
+        >;
+
+    using Settings = typename Base::Settings;
+    using Result = typename Base::Result;
+    using ResultPtr = typename Base::ResultPtr;
+
+    ChessHarrisNode(
+        GradientSource &gradient,
+        LinesSource &lines,
+        const ChessChainControl<Float> &control,
+        const CancelControl &cancel)
+        :
+        Base("Harris", gradient, control, cancel),
+        lines_(lines),
+        harris_(this->settings_.harris)
+    {
+
+    }
+
+    // Called with mutex_ held.
+    void SettingsChanged(const Settings &settings)
+    {
+        this->harris_ = Harris<Float>(settings.harris);
+    }
+
+    ResultPtr DoGetResult()
+    {
+        auto gradient = this->input_.GetResult();
+
+        if (!gradient)
+        {
+            return {};
+        }
+
+        Harris<Float> harris;
+        bool sparseHarris;
+        Eigen::Index candidateWindow;
+        Float minimumAngle_deg;
+
+        {
+            std::lock_guard lock(this->mutex_);
+            harris = this->harris_;
+            sparseHarris = this->settings_.sparseHarris;
+            candidateWindow = this->settings_.candidateWindow;
+
+            // Lines closer in angle than this belong to the same group.
+            minimumAngle_deg = static_cast<Float>(
+                this->settings_.chess.groupSeparationDegrees);
+        }
+
+        auto result = std::make_shared<Result>();
+
+        if (!sparseHarris)
+        {
+            if (!harris.Filter(*gradient, *result))
+            {
+                return {};
+            }
+
+            return result;
+        }
+
+        auto lines = this->lines_.GetResult();
+
+        if (!lines)
+        {
+            return {};
+        }
+
+        auto candidates = GetIntersections(
+            lines->lines,
+            gradient->dx.rows(),
+            gradient->dx.cols(),
+            minimumAngle_deg);
+
+        if (
+            !harris.FilterCandidates(
+                *gradient,
+                candidates,
+                candidateWindow,
+                *result))
+        {
+            return {};
+        }
+
+        return result;
+    }
+
+private:
+    LinesSource &lines_;
+    Harris<Float> harris_;
+};
+
+
+/*
+ * Selects the vertices for the chess node, from either the Harris response
+ * and VertexFinder, or the saddle detector, as chosen by useSaddle.
+ */
+template<typename Float, typename HarrisVertices, typename SaddleVertices>
+class ChessVerticesNode
+{
+public:
+    using Result = VertexSet;
+    using ResultPtr = std::shared_ptr<const VertexSet>;
+    using UseSaddleControl = decltype(ChessChainControl<Float>::useSaddle);
+
+    ChessVerticesNode(
+        HarrisVertices &harrisVertices,
+        SaddleVertices &saddleVertices,
+        const UseSaddleControl &useSaddle,
+        const CancelControl &cancel)
+        :
+        mutex_(),
+        harrisVertices_(harrisVertices),
+        saddleVertices_(saddleVertices),
+        useSaddle_(useSaddle.Get()),
+
+        useSaddleEndpoint_(
+            PEX_THIS("ChessVerticesNode"),
+            useSaddle,
+            &ChessVerticesNode::OnUseSaddle_),
+
+        cancel_(cancel),
+        result_()
+    {
+
+    }
+
+    ChessVerticesNode(const ChessVerticesNode &) = delete;
+    ChessVerticesNode & operator=(const ChessVerticesNode &) = delete;
+
+    bool UseSaddle() const
+    {
+        std::lock_guard lock(this->mutex_);
+        return this->useSaddle_;
+    }
+
+    bool HasResult() const
+    {
+        bool hasResult;
+        bool useSaddle;
+
+        {
+            std::lock_guard lock(this->mutex_);
+            hasResult = !!this->result_;
+            useSaddle = this->useSaddle_;
+        }
+
+        bool hasInput = (useSaddle)
+            ? this->saddleVertices_.HasResult()
+            : this->harrisVertices_.HasResult();
+
+        if (!hasInput)
+        {
+            std::lock_guard lock(this->mutex_);
+            this->result_.reset();
+
+            return false;
+        }
+
+        return hasResult;
+    }
+
+    ResultPtr GetResult()
+    {
+        if (this->cancel_.Get())
+        {
+            return {};
+        }
+
+        if (this->HasResult())
+        {
+            std::lock_guard lock(this->mutex_);
+
+            if (this->result_)
+            {
+                return this->result_;
+            }
+        }
+
+        bool useSaddle = this->UseSaddle();
+
+        ResultPtr result = (useSaddle)
+            ? this->saddleVertices_.GetResult()
+            : this->harrisVertices_.GetResult();
+
+        std::lock_guard lock(this->mutex_);
+
+        if (useSaddle != this->useSaddle_)
+        {
+            // The selection changed while the vertices were computed.
+            return {};
+        }
+
+        return this->result_ = result;
+    }
+
+private:
+    void OnUseSaddle_(bool useSaddle)
+    {
+        std::lock_guard lock(this->mutex_);
+        this->useSaddle_ = useSaddle;
+        this->result_.reset();
+    }
+
+    using UseSaddleEndpoint =
+        pex::Endpoint<ChessVerticesNode, UseSaddleControl>;
+
+    mutable std::mutex mutex_;
+    HarrisVertices &harrisVertices_;
+    SaddleVertices &saddleVertices_;
+    bool useSaddle_;
+    UseSaddleEndpoint useSaddleEndpoint_;
+    CancelControl cancel_;
+    mutable ResultPtr result_;
+};
+
+
+template<typename Float>
 struct ChessChainNodes
 {
     using SourceNode = Source<ProcessMatrix>;
 
-    using Filters = ChessChainFilters;
+    using Filters = ChessChainFilters<Float>;
 
     // Common
     using MaskFilter = typename Filters::MaskFilter;
@@ -38,6 +284,7 @@ struct ChessChainNodes
     // Vertices
     using HarrisFilter = typename Filters::HarrisFilter;
     using VertexFilter = typename Filters::VertexFilter;
+    using SaddleFilter = typename Filters::SaddleFilter;
 
     using MaskNode = Node<SourceNode, MaskFilter, MaskControl>;
     using LevelNode = LevelAdjustNode<MaskNode, InProcess, double>;
@@ -48,25 +295,31 @@ struct ChessChainNodes
     using GradientNode_ = GradientNode<GaussianNode>;
 
     using CannyNode =
-        iris::Node<GradientNode_, CannyFilter, CannyControl<double>>;
+        iris::Node<GradientNode_, CannyFilter, CannyControl<Float>>;
 
     using HoughNode =
-        iris::Node<CannyNode, HoughFilter, HoughControl<double>>;
+        iris::Node<CannyNode, HoughFilter, HoughControl<Float>>;
 
-    using HarrisNode =
-        iris::Node<GradientNode_, HarrisFilter, HarrisControl<double>>;
+    using HarrisNode = ChessHarrisNode<Float, GradientNode_, HoughNode>;
 
     using VertexNode =
         iris::Node<HarrisNode, VertexFilter, VertexControl>;
 
+    // Saddle smooths the image itself, so it reads the level output.
+    using SaddleNode =
+        iris::Node<LevelNode, SaddleFilter, SaddleControl>;
+
+    using ChessVerticesNode_ =
+        ChessVerticesNode<Float, VertexNode, SaddleNode>;
+
     using Result = ChessSolution;
     using ResultPtr = std::shared_ptr<const ChessSolution>;
 
     using MixNode =
-        typename ChessNodes<VertexNode, HoughNode>::MixNode;
+        typename ChessNodes<ChessVerticesNode_, HoughNode>::MixNode;
 
     using ChessNode =
-        typename ChessNodes<VertexNode, HoughNode>::FilterNode;
+        typename ChessNodes<ChessVerticesNode_, HoughNode>::FilterNode;
 
     MaskNode mask;
     LevelNode level;
@@ -79,50 +332,65 @@ struct ChessChainNodes
 
     HarrisNode harris;
     VertexNode vertices;
+    SaddleNode saddle;
+    ChessVerticesNode_ chessVertices;
 
     MixNode mix;
     ChessNode chess;
 
     ChessChainNodes(
         SourceNode &source,
-        const ChessChainControl &control,
+        const ChessChainControl<Float> &control,
         const CancelControl &cancel);
 };
 
 
+template<typename Float>
 class ChessChain
     :
     public NodeBase
         <
-            typename ChessChainNodes::SourceNode,
-            ChessChainControl,
-            typename ChessChainNodes::Result,
-            ChessChain
+            typename ChessChainNodes<Float>::SourceNode,
+            ChessChainControl<Float>,
+            typename ChessChainNodes<Float>::Result,
+            ChessChain<Float>
         >
 {
 public:
-    using SourceNode = typename ChessChainNodes::SourceNode;
-    using ChainResults = ChessChainResults;
+    using Nodes = ChessChainNodes<Float>;
+    using SourceNode = typename Nodes::SourceNode;
+    using ChainResults = ChessChainResults<Float>;
 
     using Base = NodeBase
         <
             SourceNode,
-            ChessChainControl,
-            typename ChessChainNodes::Result,
-            ChessChain
+            ChessChainControl<Float>,
+            typename Nodes::Result,
+            ChessChain<Float>
         >;
 
     using Result = typename Base::Result;
+    using ResultPtr = typename Base::ResultPtr;
+    using Settings = typename Base::Settings;
 
     ChessChain(
         SourceNode &sourceNode,
-        const ChessChainControl &control,
+        const ChessChainControl<Float> &control,
         const CancelControl &cancel);
 
     void AutoDetectSettings();
 
+    void SettingsChanged(const Settings &settings);
+
+    // When tracking is enabled, the full chain only runs for keyframes.
     ResultPtr DoGetResult();
 
+    // Tracks from a board that is already known, without a full detection.
+    void SetKeyframe(const ChessSolution &solution);
+
+    // On tracked frames, the canny, hough, harris, saddle and vertices
+    // results are left empty, because those nodes did not run. The harris
+    // result is also empty when the saddle detector supplies the vertices.
     std::shared_ptr<ChainResults> GetChainResults();
 
     int64_t GetShapesId() const
@@ -131,12 +399,30 @@ public:
     }
 
 private:
+    // Returns nothing when a full detection is required.
+    ResultPtr Track_();
+
     draw::ShapesId linesShapesId_;
     draw::ShapesId verticesShapesId_;
     draw::ShapesId chessShapesId_;
-    ChessChainNodes nodes_;
+    Nodes nodes_;
     pex::Endpoint<ChessChain, pex::control::DefaultSignal> autoDetectEndpoint_;
+
+    // Guards the tracker without holding mutex_ while the nodes compute.
+    std::mutex trackerMutex_;
+    ChessTracker<Float> tracker_;
+
+    // Whether the last result came from the tracker. Guarded by
+    // trackerMutex_.
+    bool isTracked_;
 };
 
 
+extern template struct ChessChainNodes<float>;
+extern template struct ChessChainNodes<double>;
+
+extern template class ChessChain<float>;
+extern template class ChessChain<double>;
+
+
 } // end namespace iris
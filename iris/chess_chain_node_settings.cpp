@@ -16,6 +16,7 @@ bool HasSelectedNode(const ChessChainNodeSettings &settings)
         || settings.hough.isSelected
         || settings.harris.isSelected
         || settings.vertices.isSelected
+        || settings.saddle.isSelected
         || settings.chess.isSelected);
 }
 
@@ -22,6 +22,7 @@ struct ChessChainNodeSettingsFields
         fields::Field(&T::hough, "hough"),
         fields::Field(&T::harris, "harris"),
         fields::Field(&T::vertices, "vertices"),
+        fields::Field(&T::saddle, "saddle"),
         fields::Field(&T::chess, "chess"));
 };
 
@@ -37,6 +38,7 @@ struct ChessChainNodeSettingsTemplate
     T<draw::NodeSettingsGroup> hough;
     T<draw::NodeSettingsGroup> harris;
     T<draw::NodeSettingsGroup> vertices;
+    T<draw::NodeSettingsGroup> saddle;
     T<draw::NodeSettingsGroup> chess;
 
     static constexpr auto fields =
@@ -93,6 +95,11 @@ struct ChessChainNodeSettingsCustom
                 this->vertices.toggleSelect,
                 &Model<Base>::OnVertices_),
 
+            saddleEndpoint_(
+                this,
+                this->saddle.toggleSelect,
+                &Model<Base>::OnSaddle_),
+
             chessEndpoint_(
                 this,
                 this->chess.toggleSelect,
@@ -165,6 +172,11 @@ struct ChessChainNodeSettingsCustom
             this->Toggle_(&this->vertices);
         }
 
+        void OnSaddle_()
+        {
+            this->Toggle_(&this->saddle);
+        }
+
         void OnChess_()
         {
             this->Toggle_(&this->chess);
@@ -181,6 +193,7 @@ struct ChessChainNodeSettingsCustom
         Endpoint houghEndpoint_;
         Endpoint harrisEndpoint_;
         Endpoint verticesEndpoint_;
+        Endpoint saddleEndpoint_;
         Endpoint chessEndpoint_;
 
         draw::NodeSettingsModel *selected_;
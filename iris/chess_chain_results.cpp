@@ -5,7 +5,8 @@ namespace iris
 {
 
 
-ChessChainResults::ChessChainResults(
+template<typename Float>
+ChessChainResults<Float>::ChessChainResults(
     int64_t chessShapesId,
     int64_t linesShapesId,
     int64_t verticesShapesId)
@@ -17,8 +18,10 @@ ChessChainResults::ChessChainResults(
     canny{},
     hough{},
     harris{},
+    saddle{},
     vertices{},
     chess{},
+    isTracked(false),
     chessShapesId_(chessShapesId),
     linesShapesId_(linesShapesId),
     verticesShapesId_(verticesShapesId)
@@ -27,7 +30,8 @@ ChessChainResults::ChessChainResults(
 }
 
 
-void ChessChainResults::ClearShapes_(
+template<typename Float>
+void ChessChainResults<Float>::ClearShapes_(
     draw::AsyncShapesControl shapesControl) const
 {
     draw::Shapes chessShapes(this->chessShapesId_);
@@ -40,7 +44,18 @@ void ChessChainResults::ClearShapes_(
 }
 
 
-std::shared_ptr<draw::Pixels> ChessChainResults::DisplayNode(
+template<typename Float>
+void ChessChainResults<Float>::ReportMissingNode_() const
+{
+    if (!this->isTracked)
+    {
+        std::cout << "Cannot select a disabled node" << std::endl;
+    }
+}
+
+
+template<typename Float>
+std::shared_ptr<draw::Pixels> ChessChainResults<Float>::DisplayNode(
     const tau::Margins &margins,
     const ChessChainNodeSettings &nodeSettings,
     const draw::AsyncShapesControl &shapesControl,
@@ -62,6 +77,18 @@ std::shared_ptr<draw::Pixels> ChessChainResults::DisplayNode(
     if (nodeSettings.vertices.isSelected && this->vertices)
     {
         this->DrawVerticesResults_(
+            *this->vertices,
+            shapesControl,
+            pointsShapeSettings,
+            color);
+
+        return pixels;
+    }
+
+    if (nodeSettings.saddle.isSelected && this->saddle)
+    {
+        this->DrawVerticesResults_(
+            *this->saddle,
             shapesControl,
             pointsShapeSettings,
             color);
@@ -97,7 +124,8 @@ std::shared_ptr<draw::Pixels> ChessChainResults::DisplayNode(
 }
 
 
-std::shared_ptr<draw::Pixels> ChessChainResults::Display(
+template<typename Float>
+std::shared_ptr<draw::Pixels> ChessChainResults<Float>::Display(
     const tau::Margins &margins,
     const draw::AsyncShapesControl &shapesControl,
     const draw::LinesShapeSettings &linesShapeSettings,
@@ -159,6 +187,7 @@ std::shared_ptr<draw::Pixels> ChessChainResults::Display(
     if (this->vertices)
     {
         this->DrawVerticesResults_(
+            *this->vertices,
             shapesControl,
             pointsShapeSettings,
             color);
@@ -170,7 +199,8 @@ std::shared_ptr<draw::Pixels> ChessChainResults::Display(
 }
 
 
-std::shared_ptr<draw::Pixels> ChessChainResults::GetPreprocessedPixels_(
+template<typename Float>
+std::shared_ptr<draw::Pixels> ChessChainResults<Float>::GetPreprocessedPixels_(
     const tau::Margins &margins,
     ThreadsafeColorMap<int32_t> &color) const
 {
@@ -219,7 +249,8 @@ std::shared_ptr<draw::Pixels> ChessChainResults::GetPreprocessedPixels_(
 }
 
 
-std::shared_ptr<draw::Pixels> ChessChainResults::GetNodePixels_(
+template<typename Float>
+std::shared_ptr<draw::Pixels> ChessChainResults<Float>::GetNodePixels_(
     const tau::Margins &margins,
     const ChessChainNodeSettings &nodeSettings,
     ThreadsafeColorMap<int32_t> &color) const
@@ -228,7 +259,7 @@ std::shared_ptr<draw::Pixels> ChessChainResults::GetNodePixels_(
     {
         if (!this->mask)
         {
-            std::cout << "Cannot select a disabled node" << std::endl;
+            this->ReportMissingNode_();
             return {};
         }
 
@@ -239,7 +270,7 @@ std::shared_ptr<draw::Pixels> ChessChainResults::GetNodePixels_(
     {
         if (!this->level)
         {
-            std::cout << "Cannot select a disabled node" << std::endl;
+            this->ReportMissingNode_();
             return {};
         }
 
@@ -250,7 +281,7 @@ std::shared_ptr<draw::Pixels> ChessChainResults::GetNodePixels_(
     {
         if (!this->gaussian)
         {
-            std::cout << "Cannot select a disabled node" << std::endl;
+            this->ReportMissingNode_();
             return {};
         }
 
@@ -261,7 +292,7 @@ std::shared_ptr<draw::Pixels> ChessChainResults::GetNodePixels_(
     {
         if (!this->gradient)
         {
-            std::cout << "Cannot select a disabled node" << std::endl;
+            this->ReportMissingNode_();
             return {};
         }
 
@@ -272,7 +303,7 @@ std::shared_ptr<draw::Pixels> ChessChainResults::GetNodePixels_(
     {
         if (!this->harris)
         {
-            std::cout << "Cannot select a disabled node" << std::endl;
+            this->ReportMissingNode_();
             return {};
         }
 
@@ -283,7 +314,7 @@ std::shared_ptr<draw::Pixels> ChessChainResults::GetNodePixels_(
     {
         if (!this->vertices || !this->gaussian)
         {
-            std::cout << "Cannot select a disabled node" << std::endl;
+            this->ReportMissingNode_();
             return {};
         }
 
@@ -291,11 +322,23 @@ std::shared_ptr<draw::Pixels> ChessChainResults::GetNodePixels_(
         return color.Filter(*this->gaussian);
     }
 
+    if (nodeSettings.saddle.isSelected)
+    {
+        if (!this->saddle || !this->level)
+        {
+            this->ReportMissingNode_();
+            return {};
+        }
+
+        // Display the level output behind the saddles.
+        return color.Filter(*this->level);
+    }
+
     if (nodeSettings.canny.isSelected)
     {
         if (!this->canny)
         {
-            std::cout << "Cannot select a disabled node" << std::endl;
+            this->ReportMissingNode_();
             return {};
         }
 
@@ -306,7 +349,8 @@ std::shared_ptr<draw::Pixels> ChessChainResults::GetNodePixels_(
 }
 
 
-void ChessChainResults::DrawHoughResults_(
+template<typename Float>
+void ChessChainResults<Float>::DrawHoughResults_(
     const draw::AsyncShapesControl &shapesControl,
     const draw::LinesShapeSettings &linesShapeSettings,
     ThreadsafeColorMap<int32_t> &color,
@@ -318,8 +362,10 @@ void ChessChainResults::DrawHoughResults_(
 
     if (houghControl)
     {
-        auto scale = static_cast<double>(color.GetSettings().maximum);
-        ProcessMatrix space = houghResult.GetScaledSpace<int32_t>(scale);
+        auto scale = static_cast<Float>(color.GetSettings().maximum);
+
+        ProcessMatrix space =
+            houghResult.template GetScaledSpace<int32_t>(scale);
 
         houghControl->Set(color.Filter(space));
     }
@@ -339,17 +385,18 @@ void ChessChainResults::DrawHoughResults_(
 }
 
 
-void ChessChainResults::DrawVerticesResults_(
+template<typename Float>
+void ChessChainResults<Float>::DrawVerticesResults_(
+    const VertexSet &vertices,
     const draw::AsyncShapesControl &shapesControl,
     const draw::PointsShapeSettings &pointsShapeSettings,
     ThreadsafeColorMap<int32_t> &color) const
 {
-    assert(this->vertices);
     draw::Shapes shapes(this->verticesShapesId_);
 
     shapes.EmplaceBack<draw::PointsShape>(
         pointsShapeSettings,
-        VerticesToPoints(*this->vertices));
+        vertices.GetPoints());
 
     auto valuePointsShapeSettings = pointsShapeSettings;
     valuePointsShapeSettings.look.stroke.enable = true;
@@ -361,10 +408,14 @@ void ChessChainResults::DrawVerticesResults_(
 
     shapes.EmplaceBack<draw::ValuePointsShape>(
         valuePointsShapeSettings,
-        VerticesToValuePoints(*this->vertices));
+        vertices.valuePoints);
 
     shapesControl.Set(shapes);
 }
 
 
+template struct ChessChainResults<float>;
+template struct ChessChainResults<double>;
+
+
 } // end namespace iris
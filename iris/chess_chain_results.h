@@ -16,6 +16,7 @@
 #include "iris/harris.h"
 #include "iris/hough.h"
 #include "iris/vertex.h"
+#include "iris/saddle.h"
 #include "iris/chess.h"
 #include "iris/chess_chain_node_settings.h"
 
@@ -26,6 +27,7 @@ namespace iris
 {
 
 
+template<typename Float>
 struct ChessChainFilters
 {
     using MaskFilter = Mask<InProcess>;
@@ -33,17 +35,19 @@ struct ChessChainFilters
 
     using GaussianFilter = Gaussian<int32_t, 0>;
     using GradientFilter = Gradient<int32_t>;
-    using CannyFilter = Canny<double>;
-    using HoughFilter = Hough<double>;
+    using CannyFilter = Canny<Float>;
+    using HoughFilter = Hough<Float, uint32_t>;
 
-    using HarrisFilter = Harris<double>;
+    using HarrisFilter = Harris<Float>;
     using VertexFilter = VertexFinder;
+    using SaddleFilter = Saddle<Float>;
 };
 
 
+template<typename Float>
 struct ChessChainResults
 {
-    using Filters = ChessChainFilters;
+    using Filters = ChessChainFilters<Float>;
     std::shared_ptr<const typename Filters::MaskFilter::Result> mask;
     std::shared_ptr<const typename Filters::LevelFilter::Result> level;
 
@@ -53,10 +57,15 @@ struct ChessChainResults
     std::shared_ptr<const typename Filters::HoughFilter::Result> hough;
 
     std::shared_ptr<const typename Filters::HarrisFilter::Result> harris;
+    std::shared_ptr<const typename Filters::SaddleFilter::Result> saddle;
     std::shared_ptr<const typename Filters::VertexFilter::Result> vertices;
 
     std::shared_ptr<const typename Chess::Result> chess;
 
+    // Whether chess came from the tracker, so the detection results were
+    // not computed.
+    bool isTracked;
+
     using HoughPixelsControl =
         typename draw::PixelViewControl::AsyncPixelsControl;
 
@@ -88,6 +97,10 @@ struct ChessChainResults
 private:
     void ClearShapes_(draw::AsyncShapesControl) const;
 
+    // Selecting a node without a result is only reported when the frame
+    // was detected. Tracked frames fall back to the preprocessed pixels.
+    void ReportMissingNode_() const;
+
     std::shared_ptr<draw::Pixels> GetPreprocessedPixels_(
         const tau::Margins &margins,
         ThreadsafeColorMap<int32_t> &color) const;
@@ -104,6 +117,7 @@ private:
         HoughPixelsControl *houghControl) const;
 
     void DrawVerticesResults_(
+        const VertexSet &vertices,
         const draw::AsyncShapesControl &shapesControl,
         const draw::PointsShapeSettings &pointsShapeSettings,
         ThreadsafeColorMap<int32_t> &color) const;
@@ -115,4 +129,8 @@ private:
 };
 
 
+extern template struct ChessChainResults<float>;
+extern template struct ChessChainResults<double>;
+
+
 } // end namespace iris
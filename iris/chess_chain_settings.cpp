@@ -4,6 +4,14 @@
 template struct pex::Group
     <
         iris::ChessChainFields,
-        iris::ChessChainTemplate,
-        iris::ChessChainCustom
+        iris::ChessChainTemplate<float>::template Template,
+        iris::ChessChainCustom<float>
+    >;
+
+
+template struct pex::Group
+    <
+        iris::ChessChainFields,
+        iris::ChessChainTemplate<double>::template Template,
+        iris::ChessChainCustom<double>
     >;
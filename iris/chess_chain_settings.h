@@ -2,12 +2,15 @@
 
 
 #include <pex/group.h>
+#include <pex/range.h>
 #include <wxpex/async.h>
 #include "iris/mask_settings.h"
 #include "iris/level_settings.h"
 #include "iris/lines_chain_settings.h"
 #include "iris/vertex_chain_settings.h"
+#include "iris/saddle_settings.h"
 #include "iris/chess_settings.h"
+#include "iris/chess_tracker_settings.h"
 
 
 namespace iris
@@ -30,45 +33,75 @@ struct ChessChainFields
         fields::Field(&T::linesShape, "linesShape"),
 
         fields::Field(&T::harris, "harris"),
+        fields::Field(&T::sparseHarris, "sparseHarris"),
+        fields::Field(&T::candidateWindow, "candidateWindow"),
         fields::Field(&T::vertices, "vertices"),
+        fields::Field(&T::saddle, "saddle"),
+        fields::Field(&T::useSaddle, "useSaddle"),
         fields::Field(&T::verticesShape, "verticesShape"),
 
         fields::Field(&T::chess, "chess"),
+        fields::Field(&T::tracker, "tracker"),
         fields::Field(&T::autoDetectSettings, "autoDetectSettings"));
 };
 
 
-template<template<typename> typename T>
+using CandidateWindowRange =
+    pex::MakeRange<Eigen::Index, pex::Limit<2>, pex::Limit<64>>;
+
+
+template<typename Float>
 struct ChessChainTemplate
 {
-    T<bool> enable;
-    T<MaskGroup> mask;
-    T<LevelGroup<int32_t>> level;
+    template<template<typename> typename T>
+    struct Template
+    {
+        T<bool> enable;
+        T<MaskGroup> mask;
+        T<LevelGroup<int32_t>> level;
+
+        T<GaussianGroup<int32_t>> gaussian;
+        T<GradientGroup<int32_t>> gradient;
+
+        T<CannyGroup<Float>> canny;
+        T<HoughGroup<Float>> hough;
+        T<draw::LinesShapeGroup> linesShape;
 
-    T<GaussianGroup<int32_t>> gaussian;
-    T<GradientGroup<int32_t>> gradient;
+        T<HarrisGroup<Float>> harris;
 
-    T<CannyGroup<double>> canny;
-    T<HoughGroup<double>> hough;
-    T<draw::LinesShapeGroup> linesShape;
+        // When set, Harris is only evaluated within candidateWindow pixels of
+        // the intersections of the Hough lines.
+        T<bool> sparseHarris;
 
-    T<HarrisGroup<double>> harris;
-    T<VertexGroup> vertices;
-    T<draw::PointsShapeGroup> verticesShape;
+        T<CandidateWindowRange> candidateWindow;
 
-    T<ChessGroup> chess;
-    T<pex::MakeSignal> autoDetectSettings;
+        T<VertexGroup> vertices;
+        T<SaddleGroup> saddle;
 
-    static constexpr auto fields = ChessChainFields<ChessChainTemplate>::fields;
-    static constexpr auto fieldsTypeName = "ChessChainSettings";
+        // When set, the chess node reads its vertices from the saddle
+        // detector instead of from Harris and the vertex finder.
+        T<bool> useSaddle;
+
+        T<draw::PointsShapeGroup> verticesShape;
+
+        T<ChessGroup> chess;
+        T<ChessTrackerGroup> tracker;
+        T<pex::MakeSignal> autoDetectSettings;
+
+        static constexpr auto fields = ChessChainFields<Template>::fields;
+        static constexpr auto fieldsTypeName = "ChessChainSettings";
+    };
 };
 
 
+template<typename Float>
 struct ChessChainCustom
 {
     template<typename Base>
     struct Plain: public Base
     {
+        static constexpr Eigen::Index defaultCandidateWindow = 8;
+
         Plain()
             :
             Base{
@@ -79,15 +112,20 @@ struct ChessChainCustom
                 GaussianSettings<int32_t>{},
                 GradientSettings<int32_t>{},
 
-                CannySettings<double>{},
-                HoughSettings<double>{},
+                CannySettings<Float>{},
+                HoughSettings<Float>{},
                 draw::LinesShapeSettings{},
 
-                HarrisSettings<double>{},
+                HarrisSettings<Float>{},
+                false,
+                defaultCandidateWindow,
                 VertexSettings{},
+                SaddleSettings{},
+                false,
                 draw::PointsShapeSettings{},
 
                 ChessSettings{},
+                ChessTrackerSettings{},
                 {}}
         {
             this->gaussian.sigma = 2.0;
@@ -152,17 +190,30 @@ struct ChessChainCustom
 };
 
 
+template<typename Float>
 using ChessChainGroup =
-    pex::Group<ChessChainFields, ChessChainTemplate, ChessChainCustom>;
+    pex::Group
+    <
+        ChessChainFields,
+        ChessChainTemplate<Float>::template Template,
+        ChessChainCustom<Float>
+    >;
+
+template<typename Float>
+using ChessChainSettings = typename ChessChainGroup<Float>::Plain;
 
-using ChessChainSettings = typename ChessChainGroup::Plain;
-using ChessChainControl = typename ChessChainGroup::DefaultControl;
-using ChessChainModel = typename ChessChainGroup::Model;
+template<typename Float>
+using ChessChainControl = typename ChessChainGroup<Float>::DefaultControl;
 
+template<typename Float>
+using ChessChainModel = typename ChessChainGroup<Float>::Model;
 
-DECLARE_EQUALITY_OPERATORS(ChessChainSettings)
-DECLARE_OUTPUT_STREAM_OPERATOR(ChessChainSettings)
 
+DECLARE_EQUALITY_OPERATORS(ChessChainSettings<float>)
+DECLARE_OUTPUT_STREAM_OPERATOR(ChessChainSettings<float>)
+
+DECLARE_EQUALITY_OPERATORS(ChessChainSettings<double>)
+DECLARE_OUTPUT_STREAM_OPERATOR(ChessChainSettings<double>)
 
 
 } // end namespace iris
@@ -171,6 +222,14 @@ DECLARE_OUTPUT_STREAM_OPERATOR(ChessChainSettings)
 extern template struct pex::Group
     <
         iris::ChessChainFields,
-        iris::ChessChainTemplate,
-        iris::ChessChainCustom
+        iris::ChessChainTemplate<float>::template Template,
+        iris::ChessChainCustom<float>
+    >;
+
+
+extern template struct pex::Group
+    <
+        iris::ChessChainFields,
+        iris::ChessChainTemplate<double>::template Template,
+        iris::ChessChainCustom<double>
     >;
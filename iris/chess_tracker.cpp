@@ -0,0 +1,420 @@
+#include "iris/chess_tracker.h"
+
+#include <cmath>
+#include <cstdint>
+#include <tau/svd.h>
+
+#include "iris/chess/find_vertex.h"
+
+
+namespace iris
+{
+
+
+namespace
+{
+
+
+// Moves the centroid of the points to the origin, and scales them to an
+// average distance of sqrt(2) from it, which conditions the homography
+// factors.
+GridHomography GetConditioning(const std::vector<tau::Point2d<double>> &points)
+{
+    double x = 0.0;
+    double y = 0.0;
+
+    for (auto &point: points)
+    {
+        x += point.x;
+        y += point.y;
+    }
+
+    auto count = static_cast<double>(points.size());
+    x /= count;
+    y /= count;
+
+    double distance = 0.0;
+
+    for (auto &point: points)
+    {
+        distance += std::hypot(point.x - x, point.y - y);
+    }
+
+    distance /= count;
+
+    double scale = (distance > 0.0) ? std::sqrt(2.0) / distance : 1.0;
+
+    GridHomography result = GridHomography::Identity();
+    result(0, 0) = scale;
+    result(0, 2) = -scale * x;
+    result(1, 1) = scale;
+    result(1, 2) = -scale * y;
+
+    return result;
+}
+
+
+// Returns nothing when the homography collapses the line's direction.
+std::optional<tau::Line2d<double>> TransformLine(
+    const GridHomography &homography,
+    const tau::Line2d<double> &line)
+{
+    auto first = Project(homography, line.point);
+
+    auto second = Project(
+        homography,
+        tau::Point2d<double>(
+            line.point.x + line.vector.x,
+            line.point.y + line.vector.y));
+
+    double x = second.x - first.x;
+    double y = second.y - first.y;
+    double length = std::hypot(x, y);
+
+    if (length == 0.0 || !std::isfinite(length))
+    {
+        return {};
+    }
+
+    return tau::Line2d<double>(
+        first,
+        tau::Vector2d<double>(x / length, y / length));
+}
+
+
+std::optional<std::vector<tau::Line2d<double>>> TransformLines(
+    const GridHomography &homography,
+    const std::vector<tau::Line2d<double>> &lines)
+{
+    std::vector<tau::Line2d<double>> result;
+    result.reserve(lines.size());
+
+    for (auto &line: lines)
+    {
+        auto transformed = TransformLine(homography, line);
+
+        if (!transformed)
+        {
+            return {};
+        }
+
+        result.push_back(*transformed);
+    }
+
+    return result;
+}
+
+
+} // end anonymous namespace
+
+
+std::optional<GridHomography> FitGridHomography(const NamedVertices &vertices)
+{
+    using Index = Eigen::Index;
+
+    if (vertices.size() < 4)
+    {
+        return {};
+    }
+
+    std::vector<tau::Point2d<double>> logicals;
+    std::vector<tau::Point2d<double>> pixels;
+    logicals.reserve(vertices.size());
+    pixels.reserve(vertices.size());
+
+    for (auto &vertex: vertices)
+    {
+        logicals.push_back(vertex.logical.template Cast<double>());
+        pixels.push_back(vertex.pixel);
+    }
+
+    GridHomography fromLogical = GetConditioning(logicals);
+    GridHomography fromPixel = GetConditioning(pixels);
+
+    auto vertexCount = static_cast<Index>(vertices.size());
+    Eigen::Matrix<double, Eigen::Dynamic, 9> factors(2 * vertexCount, 9);
+
+    for (Index i = 0; i < vertexCount; ++i)
+    {
+        auto logical = Project(fromLogical, logicals[static_cast<size_t>(i)]);
+        auto pixel = Project(fromPixel, pixels[static_cast<size_t>(i)]);
+
+        factors.row(2 * i) <<
+            -logical.x,
+            -logical.y,
+            -1,
+            0,
+            0,
+            0,
+            pixel.x * logical.x,
+            pixel.x * logical.y,
+            pixel.x;
+
+        factors.row(2 * i + 1) <<
+            0,
+            0,
+            0,
+            -logical.x,
+            -logical.y,
+            -1,
+            pixel.y * logical.x,
+            pixel.y * logical.y,
+            pixel.y;
+    }
+
+    GridHomography conditioned =
+        tau::SvdSolve(factors).reshaped<Eigen::RowMajor>(3, 3);
+
+    GridHomography result = fromPixel.inverse() * conditioned * fromLogical;
+
+    if (!result.allFinite() || result(2, 2) == 0.0)
+    {
+        return {};
+    }
+
+    result.array() /= result(2, 2);
+
+    return result;
+}
+
+
+tau::Point2d<double> Project(
+    const GridHomography &homography,
+    const tau::Point2d<double> &point)
+{
+    Eigen::Vector3<double> projected =
+        homography * Eigen::Vector3<double>(point.x, point.y, 1.0);
+
+    return tau::Point2d<double>(
+        projected(0) / projected(2),
+        projected(1) / projected(2));
+}
+
+
+template<typename Float>
+ChessTracker<Float>::ChessTracker(
+    const ChessTrackerSettings &settings,
+    const HarrisSettings<Float> &harrisSettings,
+    const VertexSettings &vertexSettings)
+    :
+    settings_(settings),
+    harris_(harrisSettings),
+    vertexFinder_(vertexSettings),
+    keyframe_(),
+    keyframeHomography_(GridHomography::Identity()),
+    pixels_(),
+    velocities_(),
+    isTracking_(false),
+    frameCount_(0)
+{
+
+}
+
+
+template<typename Float>
+void ChessTracker<Float>::SetKeyframe(const ChessSolution &solution)
+{
+    this->Reset();
+
+    if (!this->settings_.enable)
+    {
+        return;
+    }
+
+    auto homography = FitGridHomography(solution.vertices);
+
+    if (!homography)
+    {
+        return;
+    }
+
+    this->keyframe_ = solution;
+    this->keyframeHomography_ = *homography;
+    this->pixels_ = NamedVerticesToPixels(solution.vertices);
+    this->velocities_.assign(this->pixels_.size(), Point(0.0, 0.0));
+    this->isTracking_ = true;
+}
+
+
+template<typename Float>
+void ChessTracker<Float>::Reset()
+{
+    this->isTracking_ = false;
+    this->frameCount_ = 0;
+}
+
+
+template<typename Float>
+bool ChessTracker<Float>::NeedsKeyframe() const
+{
+    if (!this->isTracking_)
+    {
+        return true;
+    }
+
+    return this->settings_.keyframeInterval > 0
+        && this->frameCount_ >= this->settings_.keyframeInterval;
+}
+
+
+template<typename Float>
+std::vector<typename ChessTracker<Float>::Point>
+ChessTracker<Float>::GetPredictions_() const
+{
+    // Constant velocity
+    std::vector<Point> result;
+    result.reserve(this->pixels_.size());
+
+    for (size_t i = 0; i < this->pixels_.size(); ++i)
+    {
+        result.emplace_back(
+            this->pixels_[i].x + this->velocities_[i].x,
+            this->pixels_[i].y + this->velocities_[i].y);
+    }
+
+    return result;
+}
+
+
+template<typename Float>
+bool ChessTracker<Float>::Update_(
+    const std::vector<Point> &predictions,
+    const VertexSet &vertices,
+    ChessSolution &result)
+{
+    auto &keyframeVertices = this->keyframe_.vertices;
+
+    VertexIndex vertexIndex(
+        vertices,
+        static_cast<double>(this->settings_.window));
+
+    // Each detected vertex may be claimed by one prediction.
+    std::vector<uint8_t> isClaimed(vertices.size(), 0);
+
+    // The keyframe index of each found vertex.
+    std::vector<size_t> foundIndices;
+    NamedVertices found;
+
+    for (size_t i = 0; i < predictions.size(); ++i)
+    {
+        auto match = vertexIndex.FindVertex(predictions[i]);
+
+        if (!match || isClaimed[*match])
+        {
+            continue;
+        }
+
+        isClaimed[*match] = 1;
+        foundIndices.push_back(i);
+
+        found.push_back(
+            {keyframeVertices[i].logical, vertices.GetPoint(*match)});
+    }
+
+    auto homography = FitGridHomography(found);
+
+    if (!homography)
+    {
+        this->Reset();
+
+        return false;
+    }
+
+    // Reject the vertices that do not fit the grid, and refit the homography
+    // to the rest.
+    size_t kept = 0;
+
+    for (size_t i = 0; i < found.size(); ++i)
+    {
+        auto expected = Project(
+            *homography,
+            found[i].logical.template Cast<double>());
+
+        double error = std::hypot(
+            found[i].pixel.x - expected.x,
+            found[i].pixel.y - expected.y);
+
+        if (error <= this->settings_.maximumError)
+        {
+            found[kept] = found[i];
+            foundIndices[kept] = foundIndices[i];
+            ++kept;
+        }
+    }
+
+    found.resize(kept);
+    foundIndices.resize(kept);
+
+    double fraction =
+        static_cast<double>(kept)
+        / static_cast<double>(keyframeVertices.size());
+
+    if (fraction < this->settings_.minimumFraction)
+    {
+        this->Reset();
+
+        return false;
+    }
+
+    homography = FitGridHomography(found);
+
+    if (!homography)
+    {
+        this->Reset();
+
+        return false;
+    }
+
+    // The lines of the keyframe move with the board.
+    GridHomography motion = *homography * this->keyframeHomography_.inverse();
+    auto lines = TransformLines(motion, this->keyframe_.lines);
+    auto horizontal = TransformLines(motion, this->keyframe_.horizontal);
+    auto vertical = TransformLines(motion, this->keyframe_.vertical);
+
+    if (!lines || !horizontal || !vertical)
+    {
+        this->Reset();
+
+        return false;
+    }
+
+    // Vertices that were found move to their detected position. The rest
+    // move with the board.
+    std::vector<Point> pixels;
+    pixels.reserve(keyframeVertices.size());
+
+    for (auto &vertex: keyframeVertices)
+    {
+        pixels.push_back(
+            Project(*homography, vertex.logical.template Cast<double>()));
+    }
+
+    for (size_t i = 0; i < found.size(); ++i)
+    {
+        pixels[foundIndices[i]] = found[i].pixel;
+    }
+
+    for (size_t i = 0; i < pixels.size(); ++i)
+    {
+        this->velocities_[i] = Point(
+            pixels[i].x - this->pixels_[i].x,
+            pixels[i].y - this->pixels_[i].y);
+    }
+
+    this->pixels_ = std::move(pixels);
+    ++this->frameCount_;
+
+    result.lines = std::move(*lines);
+    result.horizontal = std::move(*horizontal);
+    result.vertical = std::move(*vertical);
+    result.vertices = std::move(found);
+
+    return true;
+}
+
+
+template class ChessTracker<float>;
+template class ChessTracker<double>;
+
+
+} // end namespace iris
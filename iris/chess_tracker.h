@@ -0,0 +1,128 @@
+#pragma once
+
+
+#include <optional>
+#include <vector>
+#include <tau/eigen.h>
+#include <tau/vector2d.h>
+
+#include "iris/gradient.h"
+#include "iris/harris.h"
+#include "iris/vertex.h"
+#include "iris/chess_tracker_settings.h"
+#include "iris/chess/chess_solution.h"
+
+
+namespace iris
+{
+
+
+// Maps logical grid coordinates to pixels.
+using GridHomography = Eigen::Matrix<double, 3, 3>;
+
+
+// Fits the homography from the logical to the pixel coordinates of the
+// vertices. Returns nothing for fewer than four vertices.
+std::optional<GridHomography> FitGridHomography(
+    const NamedVertices &vertices);
+
+
+tau::Point2d<double> Project(
+    const GridHomography &homography,
+    const tau::Point2d<double> &point);
+
+
+/*
+ * Follows a chessboard from frame to frame without the line detection of the
+ * full chess chain.
+ *
+ * Tracking begins from a full detection, the keyframe. Each of its vertices
+ * is predicted to move as far as it moved in the previous frame, and is found
+ * again by evaluating Harris only near the prediction. A homography from the
+ * logical grid to the image is fitted to the vertices found, and vertices
+ * that disagree with it are rejected, so that a vertex cannot trade places
+ * with a neighbor. Vertices that are not found are predicted from the
+ * homography in the next frame.
+ *
+ * Tracking is lost when too few of the keyframe's vertices are found, or
+ * when the keyframe interval has passed.
+ */
+template<typename Float>
+class ChessTracker
+{
+public:
+    using Result = ChessSolution;
+    using Point = tau::Point2d<double>;
+
+    ChessTracker(
+        const ChessTrackerSettings &settings,
+        const HarrisSettings<Float> &harrisSettings,
+        const VertexSettings &vertexSettings);
+
+    // Begins tracking from a full detection.
+    void SetKeyframe(const ChessSolution &solution);
+
+    void Reset();
+
+    // Returns true when the next frame requires a full detection.
+    bool NeedsKeyframe() const;
+
+    // Returns false when the board has been lost.
+    template<typename Value>
+    bool Track(const GradientResult<Value> &gradient, ChessSolution &result)
+    {
+        if (this->NeedsKeyframe())
+        {
+            return false;
+        }
+
+        auto predictions = this->GetPredictions_();
+        typename Harris<Float>::Result harrisResult;
+
+        bool foundMaxima = this->harris_.FilterCandidates(
+            gradient,
+            predictions,
+            this->settings_.window,
+            harrisResult);
+
+        VertexSet vertices;
+
+        if (!foundMaxima || !this->vertexFinder_.Filter(harrisResult, vertices))
+        {
+            this->Reset();
+
+            return false;
+        }
+
+        return this->Update_(predictions, vertices, result);
+    }
+
+private:
+    std::vector<Point> GetPredictions_() const;
+
+    bool Update_(
+        const std::vector<Point> &predictions,
+        const VertexSet &vertices,
+        ChessSolution &result);
+
+    ChessTrackerSettings settings_;
+    Harris<Float> harris_;
+    VertexFinder vertexFinder_;
+
+    ChessSolution keyframe_;
+    GridHomography keyframeHomography_;
+
+    // The latest position and motion of each keyframe vertex.
+    std::vector<Point> pixels_;
+    std::vector<Point> velocities_;
+
+    bool isTracking_;
+    size_t frameCount_;
+};
+
+
+extern template class ChessTracker<float>;
+extern template class ChessTracker<double>;
+
+
+} // end namespace iris
@@ -0,0 +1,10 @@
+#include "iris/chess_tracker_settings.h"
+
+
+
+template struct pex::Group
+    <
+        iris::ChessTrackerFields,
+        iris::ChessTrackerTemplate,
+        iris::ChessTrackerCustom
+    >;
@@ -0,0 +1,112 @@
+#pragma once
+
+
+#include <fields/fields.h>
+#include <pex/group.h>
+#include <pex/range.h>
+#include <tau/eigen_shim.h>
+
+
+namespace iris
+{
+
+
+template<typename T>
+struct ChessTrackerFields
+{
+    static constexpr auto fields = std::make_tuple(
+        fields::Field(&T::enable, "enable"),
+        fields::Field(&T::window, "window"),
+        fields::Field(&T::maximumError, "maximumError"),
+        fields::Field(&T::minimumFraction, "minimumFraction"),
+        fields::Field(&T::keyframeInterval, "keyframeInterval"));
+};
+
+
+template<template<typename> typename T>
+struct ChessTrackerTemplate
+{
+    using WindowLow = pex::Limit<2>;
+    using WindowHigh = pex::Limit<64>;
+
+    using ErrorLow = pex::Limit<0, 1, 10>;
+    using ErrorHigh = pex::Limit<10>;
+
+    using FractionLow = pex::Limit<0>;
+    using FractionHigh = pex::Limit<1>;
+
+    T<bool> enable;
+
+    // Vertices are searched for within window pixels of their prediction.
+    T<pex::MakeRange<Eigen::Index, WindowLow, WindowHigh>> window;
+
+    // The largest distance in pixels between a tracked vertex and the
+    // homography fitted to the board.
+    T<pex::MakeRange<double, ErrorLow, ErrorHigh>> maximumError;
+
+    // Tracking is lost when fewer than this fraction of the keyframe's
+    // vertices are found.
+    T<pex::MakeRange<double, FractionLow, FractionHigh>> minimumFraction;
+
+    // The number of frames tracked before a full detection is forced.
+    // Zero tracks until the board is lost.
+    T<size_t> keyframeInterval;
+
+    static constexpr auto fields =
+        ChessTrackerFields<ChessTrackerTemplate>::fields;
+
+    static constexpr auto fieldsTypeName = "ChessTracker";
+};
+
+
+struct ChessTrackerCustom
+{
+    template<typename Base>
+    struct Plain: public Base
+    {
+        static constexpr Eigen::Index defaultWindow = 8;
+        static constexpr double defaultMaximumError = 1.5;
+        static constexpr double defaultMinimumFraction = 0.8;
+        static constexpr size_t defaultKeyframeInterval = 30;
+
+        Plain()
+            :
+            Base{
+                false,
+                defaultWindow,
+                defaultMaximumError,
+                defaultMinimumFraction,
+                defaultKeyframeInterval}
+        {
+
+        }
+    };
+};
+
+
+using ChessTrackerGroup = pex::Group
+    <
+        ChessTrackerFields,
+        ChessTrackerTemplate,
+        ChessTrackerCustom
+    >;
+
+
+using ChessTrackerSettings = typename ChessTrackerGroup::Plain;
+using ChessTrackerModel = typename ChessTrackerGroup::Model;
+using ChessTrackerControl = typename ChessTrackerGroup::DefaultControl;
+
+
+DECLARE_OUTPUT_STREAM_OPERATOR(ChessTrackerSettings)
+DECLARE_EQUALITY_OPERATORS(ChessTrackerSettings)
+
+
+} // end namespace iris
+
+
+extern template struct pex::Group
+    <
+        iris::ChessTrackerFields,
+        iris::ChessTrackerTemplate,
+        iris::ChessTrackerCustom
+    >;
@@ -1,8 +1,10 @@
 #pragma once
 
 
+#include <algorithm>
 #include <cassert>
 #include <vector>
+#include <jive/range.h>
 #include <jive/thread_pool.h>
 #include <tau/eigen_shim.h>
 #include <tau/convolve.h>
@@ -25,6 +27,8 @@ struct Chunk
 {
     Eigen::Index index;
     Eigen::Index count;
+
+    bool operator==(const Chunk &) const = default;
 };
 
 
@@ -97,6 +101,45 @@ inline void AwaitThreads(std::vector<jive::Sentry> &sentries)
 }
 
 
+// Chunks of [0, count) for at most threadCount threads.
+inline Chunks MakeThreadChunks(size_t threadCount, Eigen::Index count)
+{
+    using Eigen::Index;
+
+    if (count == 0)
+    {
+        return {};
+    }
+
+    threadCount = static_cast<size_t>(
+        std::clamp(static_cast<Index>(threadCount), Index{1}, count));
+
+    return MakeChunks(threadCount, count);
+}
+
+
+// Runs job(chunkIndex) for each chunk on the thread pool, and waits.
+template<typename Job>
+void RunChunks(const Chunks &chunks, const Job &job)
+{
+    std::vector<jive::Sentry> sentries;
+    sentries.reserve(chunks.size());
+    auto threadPool = jive::GetThreadPool();
+
+    for (auto index: jive::Range<size_t>(0, chunks.size()))
+    {
+        sentries.emplace_back(
+            threadPool->AddJob(
+                [&job, index]()
+                {
+                    job(index);
+                }));
+    }
+
+    AwaitThreads(sentries);
+}
+
+
 template<bool normalize = false>
 struct RowFunctors
 {
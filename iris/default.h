@@ -2,6 +2,7 @@
 
 
 #include <pex/control_value.h>
+#include <pex/range.h>
 #include <tau/eigen_shim.h>
 #include <draw/size.h>
 
@@ -28,4 +29,10 @@ using ProcessMatrix =
 using MaximumControl = pex::control::Value<pex::model::Value<InProcess>>;
 
 
+// Auto detection samples every detectStride-th row and column.
+// A stride of 0 would sample nothing.
+using DetectStrideRange =
+    pex::MakeRange<size_t, pex::Limit<1>, pex::Limit<16>>;
+
+
 } // end namespace iris
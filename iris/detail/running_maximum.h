@@ -0,0 +1,326 @@
+#pragma once
+
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <tau/eigen.h>
+
+
+namespace iris
+{
+
+
+namespace detail
+{
+
+
+/*
+ * van Herk/Gil-Werman running maximum.
+ *
+ * The maximum of the values within reach of each index is found by padding
+ * the line by reach on both sides and splitting it into blocks of the window
+ * size, 2 * reach + 1. Every window spans at most two blocks, so its maximum
+ * is the larger of the suffix maximum in the first block and the prefix
+ * maximum in the second. Each takes one pass to build, so the cost is three
+ * comparisons per value, whatever the window size.
+ *
+ * The values equal to each maximum are counted in the same passes, so a
+ * maximum that is not unique within its window is found without scanning
+ * the window again.
+ *
+ * Padding never wins.
+ */
+class RunningMaximum
+{
+public:
+    using Index = Eigen::Index;
+
+    // The number of values equal to the maximum of a window.
+    using Count = int32_t;
+    using Counts = Eigen::Array<Count, Eigen::Dynamic, Eigen::Dynamic>;
+
+    RunningMaximum(Index reach)
+        :
+        reach_(reach),
+        blockSize_(2 * reach + 1)
+    {
+
+    }
+
+    Index GetPaddedCount(Index count) const
+    {
+        return count + 2 * this->reach_;
+    }
+
+    // Filters one contiguous line of count values, and counts the values
+    // that equal the maximum of each window.
+    // forward and backward, and their counts, must hold
+    // GetPaddedCount(count) values.
+    template<typename Scalar>
+    void Along(
+        const Scalar *input,
+        Scalar *output,
+        Count *outputCounts,
+        Index count,
+        Scalar *forward,
+        Count *forwardCounts,
+        Scalar *backward,
+        Count *backwardCounts) const
+    {
+        static constexpr auto lowest = std::numeric_limits<Scalar>::lowest();
+        Index paddedCount = this->GetPaddedCount(count);
+
+        // Padding has a count of zero, so it never adds to a tie.
+        auto start = [&](Scalar *values, Count *counts, Index padded)
+        {
+            Index index = padded - this->reach_;
+
+            if (index < 0 || index >= count)
+            {
+                values[padded] = lowest;
+                counts[padded] = 0;
+            }
+            else
+            {
+                values[padded] = input[index];
+                counts[padded] = 1;
+            }
+        };
+
+        auto extend = [&](
+            Scalar *values,
+            Count *counts,
+            Index padded,
+            Index previous)
+        {
+            Index index = padded - this->reach_;
+            values[padded] = values[previous];
+            counts[padded] = counts[previous];
+
+            if (index >= 0 && index < count)
+            {
+                Combine(values[padded], counts[padded], input[index], 1);
+            }
+        };
+
+        for (Index padded = 0; padded < paddedCount; ++padded)
+        {
+            if (padded % this->blockSize_ == 0)
+            {
+                start(forward, forwardCounts, padded);
+            }
+            else
+            {
+                extend(forward, forwardCounts, padded, padded - 1);
+            }
+        }
+
+        for (Index padded = paddedCount - 1; padded >= 0; --padded)
+        {
+            if (this->IsBlockEnd_(padded, paddedCount))
+            {
+                start(backward, backwardCounts, padded);
+            }
+            else
+            {
+                extend(backward, backwardCounts, padded, padded + 1);
+            }
+        }
+
+        // The window of index begins at padded index `index`.
+        for (Index index = 0; index < count; ++index)
+        {
+            output[index] = backward[index];
+            outputCounts[index] = backwardCounts[index];
+
+            if (index % this->blockSize_ == 0)
+            {
+                // The window is one whole block, already covered by
+                // backward. Combining forward would count it twice.
+                continue;
+            }
+
+            Index last = index + this->blockSize_ - 1;
+
+            Combine(
+                output[index],
+                outputCounts[index],
+                forward[last],
+                forwardCounts[last]);
+        }
+    }
+
+    // Filters across the columns of input for the rows in
+    // [firstRow, firstRow + rowCount), treating each column segment as one
+    // element, and sums the counts of the values that equal each maximum.
+    // Every step is a vectorized operation on rowCount values.
+    // forward and backward, and their counts, must have at least rowCount
+    // rows and GetPaddedCount(input.cols()) columns.
+    template<typename Lines>
+    void Across(
+        const Lines &input,
+        const Counts &inputCounts,
+        Lines &output,
+        Counts &outputCounts,
+        Index firstRow,
+        Index rowCount,
+        Lines &forward,
+        Counts &forwardCounts,
+        Lines &backward,
+        Counts &backwardCounts) const
+    {
+        using Scalar = typename Lines::Scalar;
+        static constexpr auto lowest = std::numeric_limits<Scalar>::lowest();
+
+        Index count = input.cols();
+        Index paddedCount = this->GetPaddedCount(count);
+
+        auto column = [&](auto &lines, Index index, Index first)
+        {
+            return lines.block(first, index, rowCount, 1);
+        };
+
+        auto start = [&](Lines &values, Counts &counts, Index padded)
+        {
+            Index index = padded - this->reach_;
+
+            if (index < 0 || index >= count)
+            {
+                column(values, padded, 0).setConstant(lowest);
+                column(counts, padded, 0).setZero();
+            }
+            else
+            {
+                column(values, padded, 0) = column(input, index, firstRow);
+
+                column(counts, padded, 0) =
+                    column(inputCounts, index, firstRow);
+            }
+        };
+
+        // Equal values keep both counts.
+        auto combine = [&](
+            auto values,
+            auto counts,
+            auto otherValues,
+            auto otherCounts,
+            auto resultValues,
+            auto resultCounts)
+        {
+            resultCounts =
+                (values >= otherValues).select(counts, 0)
+                + (otherValues >= values).select(otherCounts, 0);
+
+            resultValues = values.max(otherValues);
+        };
+
+        auto extend = [&](
+            Lines &values,
+            Counts &counts,
+            Index padded,
+            Index previous)
+        {
+            Index index = padded - this->reach_;
+
+            if (index < 0 || index >= count)
+            {
+                column(values, padded, 0) = column(values, previous, 0);
+                column(counts, padded, 0) = column(counts, previous, 0);
+
+                return;
+            }
+
+            combine(
+                column(values, previous, 0),
+                column(counts, previous, 0),
+                column(input, index, firstRow),
+                column(inputCounts, index, firstRow),
+                column(values, padded, 0),
+                column(counts, padded, 0));
+        };
+
+        for (Index padded = 0; padded < paddedCount; ++padded)
+        {
+            if (padded % this->blockSize_ == 0)
+            {
+                start(forward, forwardCounts, padded);
+            }
+            else
+            {
+                extend(forward, forwardCounts, padded, padded - 1);
+            }
+        }
+
+        for (Index padded = paddedCount - 1; padded >= 0; --padded)
+        {
+            if (this->IsBlockEnd_(padded, paddedCount))
+            {
+                start(backward, backwardCounts, padded);
+            }
+            else
+            {
+                extend(backward, backwardCounts, padded, padded + 1);
+            }
+        }
+
+        for (Index index = 0; index < count; ++index)
+        {
+            if (index % this->blockSize_ == 0)
+            {
+                // The window is one whole block, already covered by
+                // backward.
+                column(output, index, firstRow) = column(backward, index, 0);
+
+                column(outputCounts, index, firstRow) =
+                    column(backwardCounts, index, 0);
+
+                continue;
+            }
+
+            Index last = index + this->blockSize_ - 1;
+
+            combine(
+                column(backward, index, 0),
+                column(backwardCounts, index, 0),
+                column(forward, last, 0),
+                column(forwardCounts, last, 0),
+                column(output, index, firstRow),
+                column(outputCounts, index, firstRow));
+        }
+    }
+
+private:
+    template<typename Scalar>
+    static void Combine(
+        Scalar &value,
+        Count &count,
+        Scalar otherValue,
+        Count otherCount)
+    {
+        if (otherValue > value)
+        {
+            value = otherValue;
+            count = otherCount;
+        }
+        else if (otherValue == value)
+        {
+            count += otherCount;
+        }
+    }
+
+    bool IsBlockEnd_(Index padded, Index paddedCount) const
+    {
+        return (padded == paddedCount - 1)
+            || ((padded + 1) % this->blockSize_ == 0);
+    }
+
+    Index reach_;
+    Index blockSize_;
+};
+
+
+} // end namespace detail
+
+
+} // end namespace iris
@@ -0,0 +1,234 @@
+#pragma once
+
+
+#include <cstdint>
+#include <iterator>
+#include <vector>
+#include <tau/eigen.h>
+
+#include "iris/chunks.h"
+#include "iris/detail/suppression_detail.h"
+
+
+namespace iris
+{
+
+
+namespace detail
+{
+
+
+/*
+ * Suppresses a list of candidates by bucketing them into a grid of
+ * window-sized cells. Every candidate within a window of another lies in
+ * the same cell or one of its eight neighbors, so each candidate is only
+ * compared to the candidates of nine cells.
+ *
+ * Candidates must be listed in storage order, which decides between equal
+ * maxima like AsyncSuppression does.
+ *
+ * The candidates must be the non-zero values of the input, as listed by
+ * ListNonZero. Only then does the result match the dense Suppression, where
+ * the zeros also take part in each window. Negative candidates do not: a
+ * negative value next to an unlisted zero is still kept here.
+ */
+template<typename Scalar>
+class SparseSuppressor
+{
+public:
+    using Index = Eigen::Index;
+    using LocalMaximum = LocalMaximumTemplate<Scalar>;
+    using Candidates = std::vector<LocalMaximum>;
+
+    SparseSuppressor(Index windowSize, Index rows, Index columns)
+        :
+        windowSize_(windowSize),
+        reach_(windowSize - 1),
+        cellRows_((rows + windowSize - 1) / windowSize),
+        cellColumns_((columns + windowSize - 1) / windowSize),
+        offsets_(),
+        members_()
+    {
+
+    }
+
+    // Returns the surviving candidates, in storage order.
+    Candidates operator()(const Candidates &candidates, size_t threadCount)
+    {
+        this->Bucket_(candidates);
+
+        auto count = static_cast<Index>(candidates.size());
+
+        // Candidates without a larger neighbor.
+        std::vector<uint8_t> isMaximum(candidates.size(), 0);
+
+        auto chunks = chunk::MakeThreadChunks(threadCount, count);
+
+        chunk::RunChunks(
+            chunks,
+            [&](size_t chunkIndex)
+            {
+                auto &chunk = chunks[chunkIndex];
+                auto end = static_cast<size_t>(chunk.index + chunk.count);
+
+                for (
+                    auto index = static_cast<size_t>(chunk.index);
+                    index < end;
+                    ++index)
+                {
+                    isMaximum[index] = !this->HasNeighbor_(
+                        candidates,
+                        index,
+                        [&](size_t other)
+                        {
+                            return candidates[other].value
+                                > candidates[index].value;
+                        });
+                }
+            });
+
+        // A maximum is suppressed by an earlier kept maximum in its window,
+        // which can only be equal to it. Earlier maxima are already decided.
+        std::vector<uint8_t> isKept(candidates.size(), 0);
+        Candidates result;
+
+        for (size_t index = 0; index < candidates.size(); ++index)
+        {
+            if (!isMaximum[index])
+            {
+                continue;
+            }
+
+            bool isSuppressed = this->HasNeighbor_(
+                candidates,
+                index,
+                [&](size_t other)
+                {
+                    return other < index && isKept[other];
+                });
+
+            if (!isSuppressed)
+            {
+                isKept[index] = 1;
+                result.push_back(candidates[index]);
+            }
+        }
+
+        return result;
+    }
+
+private:
+    Index GetCell_(Index cellRow, Index cellColumn) const
+    {
+        return cellRow * this->cellColumns_ + cellColumn;
+    }
+
+    Index GetCell_(const LocalMaximum &candidate) const
+    {
+        return this->GetCell_(
+            candidate.row / this->windowSize_,
+            candidate.column / this->windowSize_);
+    }
+
+    // Sorts the candidate indices by cell, keeping storage order within
+    // each cell.
+    void Bucket_(const Candidates &candidates)
+    {
+        auto cellCount =
+            static_cast<size_t>(this->cellRows_ * this->cellColumns_);
+
+        this->offsets_.assign(cellCount + 1, 0);
+
+        for (auto &candidate: candidates)
+        {
+            auto cell = static_cast<size_t>(this->GetCell_(candidate));
+            ++this->offsets_[cell + 1];
+        }
+
+        for (size_t cell = 1; cell <= cellCount; ++cell)
+        {
+            this->offsets_[cell] += this->offsets_[cell - 1];
+        }
+
+        this->members_.resize(candidates.size());
+        std::vector<size_t> next(
+            this->offsets_.begin(),
+            std::prev(this->offsets_.end()));
+
+        for (size_t index = 0; index < candidates.size(); ++index)
+        {
+            auto cell = static_cast<size_t>(this->GetCell_(candidates[index]));
+            this->members_[next[cell]++] = index;
+        }
+    }
+
+    // Returns true if any candidate within the window of candidates[index]
+    // satisfies the predicate.
+    template<typename Predicate>
+    bool HasNeighbor_(
+        const Candidates &candidates,
+        size_t index,
+        const Predicate &predicate) const
+    {
+        auto &candidate = candidates[index];
+        Index cellRow = candidate.row / this->windowSize_;
+        Index cellColumn = candidate.column / this->windowSize_;
+
+        Index firstRow = std::max(Index{0}, cellRow - 1);
+        Index lastRow = std::min(this->cellRows_ - 1, cellRow + 1);
+        Index firstColumn = std::max(Index{0}, cellColumn - 1);
+        Index lastColumn = std::min(this->cellColumns_ - 1, cellColumn + 1);
+
+        for (Index row = firstRow; row <= lastRow; ++row)
+        {
+            for (Index column = firstColumn; column <= lastColumn; ++column)
+            {
+                auto cell = static_cast<size_t>(this->GetCell_(row, column));
+                auto end = this->offsets_[cell + 1];
+
+                for (
+                    auto member = this->offsets_[cell];
+                    member < end;
+                    ++member)
+                {
+                    auto other = this->members_[member];
+
+                    if (other == index)
+                    {
+                        continue;
+                    }
+
+                    auto &neighbor = candidates[other];
+
+                    bool isInWindow =
+                        std::abs(neighbor.row - candidate.row) <= this->reach_
+                        && std::abs(neighbor.column - candidate.column)
+                            <= this->reach_;
+
+                    if (isInWindow && predicate(other))
+                    {
+                        return true;
+                    }
+                }
+            }
+        }
+
+        return false;
+    }
+
+    Index windowSize_;
+    Index reach_;
+    Index cellRows_;
+    Index cellColumns_;
+
+    // members_[offsets_[cell]] to members_[offsets_[cell + 1] - 1] are the
+    // indices of the candidates in cell.
+    std::vector<size_t> offsets_;
+    std::vector<size_t> members_;
+};
+
+
+} // end namespace detail
+
+
+} // end namespace iris
@@ -66,7 +66,15 @@ Eigen::VectorX<T> Sample(T sigma, Eigen::Index size)
     }
     else
     {
-        static_assert(order < 2);
+        static_assert(order < 3);
+
+        T sigmaSquared = sigma * sigma;
+
+        T divisor = sigmaSquared * sigmaSquared * sigma
+            * std::sqrt(static_cast<T>(2.0) * tau::Angles<T>::pi);
+
+        return (x.array().square() - sigmaSquared) * exponential.array()
+            / divisor;
     }
 }
 
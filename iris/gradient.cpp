@@ -1,4 +1,5 @@
 #include "iris/gradient.h"
+#include "iris/histogram.h"
 
 
 namespace iris
@@ -7,30 +8,65 @@ namespace iris
 
 int32_t DetectGradientScale(
     const GradientResult<int32_t> &result,
-    double percentile)
+    double percentile,
+    size_t threads,
+    Eigen::Index stride)
 {
-    auto magnitude = result.template GetPhasor<double>().magnitude;
+    using Eigen::Index;
 
-    // Find the percentile value while ignoring the zeros.
-    // Scale the percentile to 0.9.
-    auto filtered = tau::RemoveZeros(magnitude);
+    if (result.maximum < 1 || result.scale < 1)
+    {
+        throw IrisError("gradient maximum and scale must be positive");
+    }
 
-    if (filtered.size() < 10)
+    // Magnitudes at a scale of 1 are binned by rounding up, so that only
+    // zero magnitudes fall in bin 0.
+    // As with the normalized magnitude, values above the maximum are
+    // clamped.
+    auto maximum = static_cast<size_t>(result.maximum);
+    auto scale = static_cast<int64_t>(result.scale);
+
+    auto toBin = [&](Index row, Index column) -> size_t
+    {
+        auto dx = static_cast<int64_t>(result.dx(row, column)) / scale;
+        auto dy = static_cast<int64_t>(result.dy(row, column)) / scale;
+        auto squared = dx * dx + dy * dy;
+
+        if (squared == 0)
+        {
+            return 0;
+        }
+
+        auto magnitude = static_cast<size_t>(
+            std::ceil(std::sqrt(static_cast<double>(squared))));
+
+        return std::min(magnitude, maximum);
+    };
+
+    auto histogram = MakeHistogram(
+        maximum + 1,
+        result.dx.rows(),
+        result.dx.cols(),
+        threads,
+        stride,
+        toBin);
+
+    // Find the percentile value while ignoring the zeros.
+    if (histogram.GetTotal(1) < 10)
     {
         std::cerr << "gradient has insufficient non-zero values." << std::endl;
         return 1;
     }
 
-    auto percentileValue = tau::Percentile(filtered, percentile);
-    auto factor = 0.9 / percentileValue;
+    auto percentileBin = *histogram.GetPercentile(percentile, 1);
 
-    auto scale = static_cast<int32_t>(std::round(factor));
+    auto percentileValue =
+        static_cast<double>(percentileBin) / static_cast<double>(maximum);
 
-    std::sort(
-        std::begin(filtered),
-        std::end(filtered));
+    // Scale the percentile to 0.9.
+    auto factor = 0.9 / percentileValue;
 
-    return scale;
+    return std::max(1, static_cast<int32_t>(std::round(factor)));
 }
 
 
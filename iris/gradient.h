@@ -7,7 +7,6 @@
 #include <tau/planar.h>
 #include <tau/color.h>
 #include <tau/vector2d.h>
-#include <tau/percentile.h>
 #include <tau/color_maps/rgb.h>
 #include <tau/mono_image.h>
 #include <draw/pixels.h>
@@ -49,12 +48,18 @@ template<typename Value>
 struct GradientResult
 {
     Value maximum;
+
+    // The scale applied to the derivative kernels.
+    // dx and dy are exact multiples of scale.
+    Value scale;
+
     tau::MonoImage<Value> dx;
     tau::MonoImage<Value> dy;
 
     GradientResult()
         :
         maximum{},
+        scale{1},
         dx{},
         dy{}
     {
@@ -64,6 +69,7 @@ struct GradientResult
     GradientResult(Value maximum_, Eigen::Index rows, Eigen::Index cols)
         :
         maximum(maximum_),
+        scale{1},
         dx(rows, cols),
         dy(rows, cols)
     {
@@ -143,6 +149,7 @@ struct GradientResult
     {
         GradientResult trimmed{};
         trimmed.maximum = this->maximum;
+        trimmed.scale = this->scale;
         trimmed.dx = margins.RemoveMargin(this->dx);
         trimmed.dy = margins.RemoveMargin(this->dy);
 
@@ -255,6 +262,7 @@ public:
         }
 
         result.maximum = this->differentiate_.GetMaximum();
+        result.scale = this->differentiate_.GetScale();
         result.dx.resize(input.rows(), input.cols());
         result.dy.resize(input.rows(), input.cols());
 
@@ -276,9 +284,15 @@ private:
 };
 
 
+// Chooses the scale that places the given percentile of non-zero gradient
+// magnitudes at 0.9 of the maximum.
+// The derivative is linear, so the magnitudes at a scale of 1 are recovered
+// from a result computed at any scale.
 int32_t DetectGradientScale(
     const GradientResult<int32_t> &result,
-    double percentile);
+    double percentile,
+    size_t threads = GradientSettings<int32_t>::defaultThreads,
+    Eigen::Index stride = 1);
 
 
 template<typename SourceNode>
@@ -308,11 +322,6 @@ public:
 
     void AutoDetectSettings()
     {
-        auto settings = this->control_.Get();
-        settings.scale = 1;
-
-        // Update the filter with our temporary adjustment to the scale.
-        this->OnSettingsChanged(settings);
         auto filtered = this->GetResult();
 
         if (!filtered)
@@ -320,14 +329,16 @@ public:
             std::cerr << "Unable to detect gradient without input."
                 << std::endl;
 
-            this->OnSettingsChanged(this->control_.Get());
-
             return;
         }
 
+        auto settings = this->control_.Get();
+
         auto detected = DetectGradientScale(
             *filtered,
-            this->control_.percentile.Get());
+            settings.percentile,
+            settings.threads,
+            static_cast<Eigen::Index>(settings.detectStride));
 
         this->control_.scale.Set(detected);
     }
@@ -22,7 +22,8 @@ struct GradientFields
         fields::Field(&T::scale, "scale"),
         fields::Field(&T::threads, "threads"),
         fields::Field(&T::autoDetectSettings, "autoDetectSettings"),
-        fields::Field(&T::percentile, "percentile"));
+        fields::Field(&T::percentile, "percentile"),
+        fields::Field(&T::detectStride, "detectStride"));
 
     static constexpr auto fieldsTypeName = "Gradient";
 };
@@ -42,6 +43,8 @@ struct GradientTemplate
         T<pex::MakeSignal> autoDetectSettings;
         T<double> percentile;
 
+        T<DetectStrideRange> detectStride;
+
         static constexpr auto fields = GradientFields<Template>::fields;
     };
 };
@@ -59,6 +62,7 @@ struct GradientCustom
         static constexpr Value defaultScale = 1;
         static constexpr size_t defaultThreads = 4;
         static constexpr double defaultPercentile = 0.995;
+        static constexpr size_t defaultDetectStride = 1;
 
         Plain()
             :
@@ -69,7 +73,8 @@ struct GradientCustom
                 defaultScale,
                 defaultThreads,
                 {},
-                defaultPercentile}
+                defaultPercentile,
+                defaultDetectStride}
         {
 
         }
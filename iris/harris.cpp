@@ -0,0 +1,15 @@
+#include "iris/harris.h"
+
+
+namespace iris
+{
+
+
+template struct HarrisResult<float>;
+template class Harris<float>;
+
+template struct HarrisResult<double>;
+template class Harris<double>;
+
+
+} // end namespace iris
@@ -1,9 +1,16 @@
 #pragma once
 
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <tuple>
+#include <vector>
 #include <fields/fields.h>
 #include <pex/interface.h>
 #include <tau/eigen.h>
 #include <tau/vector2d.h>
+#include <tau/line2d.h>
 #include <draw/pixels.h>
 #include <tau/mono_image.h>
 
@@ -17,11 +24,49 @@ namespace iris
 {
 
 
+template<typename Float>
+struct HarrisResult
+{
+    using Maxima = LocalMaxima<Float>;
+
+    Eigen::Index rowCount = 0;
+    Eigen::Index columnCount = 0;
+
+    // The non-zero values of the thresholded response, in row-major order.
+    // Only the local maxima remain when suppression is enabled.
+    Maxima maxima;
+
+    Eigen::Index rows() const
+    {
+        return this->rowCount;
+    }
+
+    Eigen::Index cols() const
+    {
+        return this->columnCount;
+    }
+
+    tau::MonoImage<Float> GetResponse() const
+    {
+        tau::MonoImage<Float> response;
+
+        MaximaToMatrix(
+            this->maxima,
+            this->rowCount,
+            this->columnCount,
+            response);
+
+        return response;
+    }
+};
+
+
 template<typename Float>
 class Harris
 {
 public:
-    using Result = tau::MonoImage<Float>;
+    using Result = HarrisResult<Float>;
+    using Image = tau::MonoImage<Float>;
 
     Harris() = default;
 
@@ -46,79 +91,794 @@ public:
             return false;
         }
 
-        Result dx = gradient.dx.template cast<Float>();
-        Result dy = gradient.dy.template cast<Float>();
+        using Eigen::Index;
 
-        Result dxSquared = dx.array().square();
-        Result dxSquaredResult(dxSquared.rows(), dxSquared.cols());
-        Result dySquared = dy.array().square();
-        Result dySquaredResult(dySquared.rows(), dySquared.cols());
-        Result dxdy = dx.array() * dy.array();
-        Result dxdyResult(dxdy.rows(), dxdy.cols());
+        Index rows = gradient.dx.rows();
+        Index columns = gradient.dx.cols();
 
-        // Window the gradient data using the gaussian kernel.
-        auto threadedDxSquared = ThreadedRowGaussian(
-            this->gaussianKernel_,
-            dxSquared,
-            dxSquaredResult,
-            this->settings_.threads);
+        result.rowCount = rows;
+        result.columnCount = columns;
 
-        auto threadedDySquared = ThreadedColumnGaussian(
-            this->gaussianKernel_,
-            dySquared,
-            dySquaredResult,
-            this->settings_.threads);
+        std::vector<Region> bands;
 
-        auto threadedDxDy = jive::GetThreadPool()->AddJob(
-            [this, &dxdy, &dxdyResult]()
-            {
-                this->gaussianKernel_.Filter(dxdy, dxdyResult);
-            });
+        if (rows > 0 && columns > 0)
+        {
+            Index bandRows = this->GetBandRows_(rows, columns);
 
-        threadedDxSquared.Await();
-        threadedDySquared.Await();
-        threadedDxDy.Wait();
+            for (Index firstRow = 0; firstRow < rows; firstRow += bandRows)
+            {
+                bands.push_back(
+                    Region{
+                        firstRow,
+                        0,
+                        std::min(bandRows, rows - firstRow),
+                        columns});
+            }
+        }
 
-        Result response =
-            dxSquaredResult.array() * dySquaredResult.array()
-            - dxdyResult.array().square()
-            - this->settings_.alpha
-                * (dxSquaredResult.array() + dySquaredResult.array())
-                    .square();
+        // The bands are listed in storage order.
+        auto listed = this->ListRegions_(gradient.dx, gradient.dy, bands);
+        this->Threshold_(listed);
 
         if (this->settings_.suppress)
         {
-            Suppression(
-                this->settings_.threads,
-                this->settings_.window,
-                this->Threshold(response),
-                result);
+            result.maxima = detail::SparseSuppressor<Float>(
+                static_cast<Index>(this->settings_.window),
+                rows,
+                columns)(listed.values, this->settings_.threads);
+        }
+        else
+        {
+            result.maxima = std::move(listed.values);
+        }
 
-            return true;
+        return true;
+    }
+
+    /*
+     * Evaluates the response only within radius of each candidate, e.g. the
+     * intersections of Hough lines or the vertices of the previous frame,
+     * so that no full-frame pass is needed.
+     *
+     * The threshold is relative to the largest value evaluated. Each window
+     * is evaluated with a margin for the suppression window, so the maxima
+     * kept near the candidates are the maxima of the full response.
+     * Overlapping windows are merged first, so no value is computed twice.
+     */
+    template<typename Value>
+    bool FilterCandidates(
+        const GradientResult<Value> &gradient,
+        const std::vector<tau::Point2d<double>> &candidates,
+        Eigen::Index radius,
+        Result &result)
+    {
+        using Eigen::Index;
+        using Maximum = typename Result::Maxima::value_type;
+
+        if (!this->settings_.enable)
+        {
+            return false;
         }
 
-        result = this->Threshold(response);
+        Index rows = gradient.dx.rows();
+        Index columns = gradient.dx.cols();
+
+        result.rowCount = rows;
+        result.columnCount = columns;
+        result.maxima.clear();
+
+        Index reach = this->settings_.suppress
+            ? static_cast<Index>(this->settings_.window) - 1
+            : 0;
+
+        // The candidates with any part of their window in the image.
+        std::vector<Point> centers;
+
+        for (auto &candidate: candidates)
+        {
+            if (!std::isfinite(candidate.x) || !std::isfinite(candidate.y))
+            {
+                continue;
+            }
+
+            Point center(
+                static_cast<Index>(std::round(candidate.x)),
+                static_cast<Index>(std::round(candidate.y)));
+
+            auto area = ClipRegion_(center.y, center.x, radius, rows, columns);
+
+            if (area.rowCount > 0 && area.columnCount > 0)
+            {
+                centers.push_back(center);
+            }
+        }
+
+        auto listed = this->ListRegions_(
+            gradient.dx,
+            gradient.dy,
+            MergeRegions_(centers, radius + reach, rows, columns));
+
+        this->Threshold_(listed);
+
+        auto isBefore = [](const Maximum &first, const Maximum &second)
+        {
+            return std::tie(first.row, first.column)
+                < std::tie(second.row, second.column);
+        };
+
+        std::sort(listed.values.begin(), listed.values.end(), isBefore);
+
+        if (this->settings_.suppress)
+        {
+            listed.values = detail::SparseSuppressor<Float>(
+                static_cast<Index>(this->settings_.window),
+                rows,
+                columns)(listed.values, this->settings_.threads);
+        }
+
+        CandidateGrid grid(centers, radius, rows, columns);
+
+        for (auto &localMaximum: listed.values)
+        {
+            if (grid.IsNear(localMaximum.row, localMaximum.column))
+            {
+                result.maxima.push_back(localMaximum);
+            }
+        }
 
         return true;
     }
 
-    Result Threshold(const Result &response)
+    Image Threshold(const Image &response)
     {
-        Float thresholdValue = this->settings_.threshold * response.maxCoeff();
+        Float thresholdValue = this->GetThreshold_(response);
         return (response.array() < thresholdValue).select(0, response);
     }
 
 private:
+    Float GetThreshold_(const Image &response) const
+    {
+        return this->settings_.threshold * response.maxCoeff();
+    }
+
+    // The number of rows in a band, sized so that a band's working set
+    // stays in L2, and so that every thread gets a band.
+    Eigen::Index GetBandRows_(Eigen::Index rows, Eigen::Index columns) const
+    {
+        using Eigen::Index;
+
+        // A band reads its rows and a halo, and holds about ten rows of
+        // intermediate values for each of its rows.
+        auto rowBytes = static_cast<Index>(sizeof(Float)) * columns * 10;
+        Index bandRows = std::max(Index{1}, bandBytes / rowBytes);
+
+        auto threads = static_cast<Index>(
+            std::max(this->settings_.threads, size_t{1}));
+
+        return std::max(
+            Index{1},
+            std::min(bandRows, (rows + threads - 1) / threads));
+    }
+
+    // A rectangle of the response.
+    struct Region
+    {
+        Eigen::Index row;
+        Eigen::Index column;
+        Eigen::Index rowCount;
+        Eigen::Index columnCount;
+    };
+
+    // The square of the given radius about (row, column), clipped to the
+    // image.
+    static Region ClipRegion_(
+        Eigen::Index row,
+        Eigen::Index column,
+        Eigen::Index radius,
+        Eigen::Index rows,
+        Eigen::Index columns)
+    {
+        using Eigen::Index;
+
+        Index firstRow = std::max(Index{0}, row - radius);
+        Index endRow = std::min(rows, row + radius + 1);
+        Index firstColumn = std::max(Index{0}, column - radius);
+        Index endColumn = std::min(columns, column + radius + 1);
+
+        return {
+            firstRow,
+            firstColumn,
+            std::max(Index{0}, endRow - firstRow),
+            std::max(Index{0}, endColumn - firstColumn)};
+    }
+
+    using Point = tau::Point2d<Eigen::Index>;
+
+    /*
+     * Merges the squares of the given radius about centers, clipped to the
+     * image, into rectangles that do not overlap.
+     *
+     * The image is split into bands of rows as tall as a square. Each square
+     * lists its column span in the bands it touches, and the overlapping
+     * spans of a band are merged. A merged span becomes a rectangle over the
+     * rows of its squares within the band.
+     */
+    static std::vector<Region> MergeRegions_(
+        const std::vector<Point> &centers,
+        Eigen::Index radius,
+        Eigen::Index rows,
+        Eigen::Index columns)
+    {
+        using Eigen::Index;
+
+        std::vector<Region> squares;
+
+        for (auto &center: centers)
+        {
+            squares.push_back(
+                ClipRegion_(center.y, center.x, radius, rows, columns));
+        }
+
+        Index side = 2 * radius + 1;
+        auto bandCount = static_cast<size_t>((rows + side - 1) / side);
+
+        auto getBand = [side](Index row)
+        {
+            return static_cast<size_t>(row / side);
+        };
+
+        // Sort the squares by band, like SparseSuppressor sorts by cell.
+        // members[offsets[band]] to members[offsets[band + 1] - 1] are the
+        // indices of the squares in band.
+        std::vector<size_t> offsets(bandCount + 1, 0);
+
+        for (auto &square: squares)
+        {
+            auto last = getBand(square.row + square.rowCount - 1);
+
+            for (auto band = getBand(square.row); band <= last; ++band)
+            {
+                ++offsets[band + 1];
+            }
+        }
+
+        for (size_t band = 1; band <= bandCount; ++band)
+        {
+            offsets[band] += offsets[band - 1];
+        }
+
+        std::vector<size_t> members(offsets.back());
+        std::vector<size_t> next(offsets.begin(), std::prev(offsets.end()));
+
+        for (size_t index = 0; index < squares.size(); ++index)
+        {
+            auto &square = squares[index];
+            auto last = getBand(square.row + square.rowCount - 1);
+
+            for (auto band = getBand(square.row); band <= last; ++band)
+            {
+                members[next[band]++] = index;
+            }
+        }
+
+        std::vector<Region> result;
+        std::vector<Region> spans;
+
+        for (size_t band = 0; band < bandCount; ++band)
+        {
+            Index bandRow = static_cast<Index>(band) * side;
+            Index bandEnd = std::min(rows, bandRow + side);
+
+            spans.clear();
+
+            for (
+                auto member = offsets[band];
+                member < offsets[band + 1];
+                ++member)
+            {
+                auto &square = squares[members[member]];
+                Index firstRow = std::max(bandRow, square.row);
+
+                Index endRow =
+                    std::min(bandEnd, square.row + square.rowCount);
+
+                spans.push_back(
+                    Region{
+                        firstRow,
+                        square.column,
+                        endRow - firstRow,
+                        square.columnCount});
+            }
+
+            std::sort(
+                spans.begin(),
+                spans.end(),
+                [](const Region &first, const Region &second)
+                {
+                    return first.column < second.column;
+                });
+
+            auto merged = result.size();
+
+            for (auto &span: spans)
+            {
+                bool overlaps = result.size() > merged
+                    && span.column
+                        < result.back().column + result.back().columnCount;
+
+                if (!overlaps)
+                {
+                    result.push_back(span);
+                    continue;
+                }
+
+                auto &last = result.back();
+                Index firstRow = std::min(last.row, span.row);
+
+                Index endRow = std::max(
+                    last.row + last.rowCount,
+                    span.row + span.rowCount);
+
+                Index endColumn = std::max(
+                    last.column + last.columnCount,
+                    span.column + span.columnCount);
+
+                last.row = firstRow;
+                last.rowCount = endRow - firstRow;
+                last.columnCount = endColumn - last.column;
+            }
+        }
+
+        return result;
+    }
+
+    /*
+     * Buckets the candidates into a grid of cells as wide as their windows,
+     * so that a value is only compared to the candidates of its cell and
+     * the eight around it.
+     *
+     * Candidates may lie up to radius beyond the image, so the grid is
+     * offset by radius.
+     */
+    class CandidateGrid
+    {
+    public:
+        using Index = Eigen::Index;
+
+        CandidateGrid(
+            const std::vector<Point> &centers,
+            Index radius,
+            Index rows,
+            Index columns)
+            :
+            centers_(centers),
+            radius_(radius),
+            cellSize_(2 * radius + 1),
+            cellRows_((rows + 2 * radius + cellSize_ - 1) / cellSize_),
+            cellColumns_((columns + 2 * radius + cellSize_ - 1) / cellSize_),
+            offsets_(),
+            members_()
+        {
+            auto cellCount =
+                static_cast<size_t>(this->cellRows_ * this->cellColumns_);
+
+            this->offsets_.assign(cellCount + 1, 0);
+
+            for (auto &center: centers)
+            {
+                ++this->offsets_[this->GetCell_(center.y, center.x) + 1];
+            }
+
+            for (size_t cell = 1; cell <= cellCount; ++cell)
+            {
+                this->offsets_[cell] += this->offsets_[cell - 1];
+            }
+
+            this->members_.resize(centers.size());
+
+            std::vector<size_t> next(
+                this->offsets_.begin(),
+                std::prev(this->offsets_.end()));
+
+            for (size_t index = 0; index < centers.size(); ++index)
+            {
+                auto &center = centers[index];
+                auto cell = this->GetCell_(center.y, center.x);
+                this->members_[next[cell]++] = index;
+            }
+        }
+
+        // Returns true if (row, column) is within radius of a candidate.
+        bool IsNear(Index row, Index column) const
+        {
+            Index cellRow = (row + this->radius_) / this->cellSize_;
+            Index cellColumn = (column + this->radius_) / this->cellSize_;
+
+            Index firstRow = std::max(Index{0}, cellRow - 1);
+            Index lastRow = std::min(this->cellRows_ - 1, cellRow + 1);
+            Index firstColumn = std::max(Index{0}, cellColumn - 1);
+
+            Index lastColumn =
+                std::min(this->cellColumns_ - 1, cellColumn + 1);
+
+            for (Index cellY = firstRow; cellY <= lastRow; ++cellY)
+            {
+                for (Index cellX = firstColumn; cellX <= lastColumn; ++cellX)
+                {
+                    auto cell = static_cast<size_t>(
+                        cellY * this->cellColumns_ + cellX);
+
+                    auto end = this->offsets_[cell + 1];
+
+                    for (
+                        auto member = this->offsets_[cell];
+                        member < end;
+                        ++member)
+                    {
+                        auto &center = this->centers_[this->members_[member]];
+
+                        if (std::abs(center.y - row) <= this->radius_
+                            && std::abs(center.x - column) <= this->radius_)
+                        {
+                            return true;
+                        }
+                    }
+                }
+            }
+
+            return false;
+        }
+
+    private:
+        size_t GetCell_(Index row, Index column) const
+        {
+            return static_cast<size_t>(
+                ((row + this->radius_) / this->cellSize_) * this->cellColumns_
+                + (column + this->radius_) / this->cellSize_);
+        }
+
+        const std::vector<Point> &centers_;
+        Index radius_;
+        Index cellSize_;
+        Index cellRows_;
+        Index cellColumns_;
+
+        // members_[offsets_[cell]] to members_[offsets_[cell + 1] - 1] are
+        // the indices of the candidates in cell.
+        std::vector<size_t> offsets_;
+        std::vector<size_t> members_;
+    };
+
+    // Buffers reused from one region to the next.
+    struct Workspace
+    {
+        Image dx;
+        Image dy;
+        Image dxSquared;
+        Image dySquared;
+        Image dxdy;
+        Image dxSquaredResult;
+        Image dySquaredResult;
+        Image dxdyColumns;
+        Image dxdyResult;
+    };
+
+    /*
+     * Computes the response in one region, reading dx and dy once with a
+     * halo for the kernels, and keeping the products of the gradient and
+     * their windowed sums in the workspace.
+     *
+     * Correlation treats values beyond the image edges as zero. dx^2 is
+     * windowed along the rows, dy^2 along the columns, and dx * dy along
+     * both.
+     */
+    template<typename Derived, typename Output>
+    void GetRegionResponse_(
+        const Eigen::MatrixBase<Derived> &dx,
+        const Eigen::MatrixBase<Derived> &dy,
+        const Region &region,
+        Workspace &workspace,
+        Output &&output) const
+    {
+        using Eigen::Index;
+
+        const auto &rowKernel = this->gaussianKernel_.rowKernel;
+        const auto &columnKernel = this->gaussianKernel_.columnKernel;
+        Index rowRadius = rowKernel.size() / 2;
+        Index columnRadius = columnKernel.size() / 2;
+
+        Index haloRow = std::max(Index{0}, region.row - columnRadius);
+
+        Index haloRowCount =
+            std::min(dx.rows(), region.row + region.rowCount + columnRadius)
+            - haloRow;
+
+        Index haloColumn = std::max(Index{0}, region.column - rowRadius);
+
+        Index haloColumnCount =
+            std::min(
+                dx.cols(),
+                region.column + region.columnCount + rowRadius)
+            - haloColumn;
+
+        Index rowOffset = region.row - haloRow;
+        Index columnOffset = region.column - haloColumn;
+        Index rowCount = region.rowCount;
+        auto &w = workspace;
+
+        w.dx = dx.block(haloRow, haloColumn, haloRowCount, haloColumnCount)
+            .template cast<Float>();
+
+        w.dy = dy.block(haloRow, haloColumn, haloRowCount, haloColumnCount)
+            .template cast<Float>();
+
+        w.dxSquared =
+            w.dx.middleRows(rowOffset, rowCount).array().square().matrix();
+
+        w.dySquared = w.dy.array().square().matrix();
+        w.dxdy = (w.dx.array() * w.dy.array()).matrix();
+
+        // Correlate dy^2 and dx * dy with the column kernel.
+        w.dySquaredResult = Image::Zero(rowCount, haloColumnCount);
+        w.dxdyColumns = Image::Zero(rowCount, haloColumnCount);
+
+        for (Index row = 0; row < rowCount; ++row)
+        {
+            for (Index tap = 0; tap < columnKernel.size(); ++tap)
+            {
+                Index source = rowOffset + row + tap - columnRadius;
+
+                if (source < 0 || source >= haloRowCount)
+                {
+                    continue;
+                }
+
+                w.dySquaredResult.row(row) +=
+                    columnKernel(tap) * w.dySquared.row(source);
+
+                w.dxdyColumns.row(row) +=
+                    columnKernel(tap) * w.dxdy.row(source);
+            }
+        }
+
+        // Correlate dx^2 and the column-windowed dx * dy with the row kernel.
+        auto correlateRows = [&](const Image &input, Image &result)
+        {
+            result = Image::Zero(rowCount, haloColumnCount);
+
+            for (Index tap = 0; tap < rowKernel.size(); ++tap)
+            {
+                Index offset = tap - rowRadius;
+                Index first = std::max(Index{0}, -offset);
+                Index end = std::min(haloColumnCount, haloColumnCount - offset);
+
+                if (end <= first)
+                {
+                    continue;
+                }
+
+                result.middleCols(first, end - first).array() +=
+                    rowKernel(tap)
+                    * input.middleCols(first + offset, end - first).array();
+            }
+        };
+
+        correlateRows(w.dxSquared, w.dxSquaredResult);
+        correlateRows(w.dxdyColumns, w.dxdyResult);
+
+        auto xx = w.dxSquaredResult.middleCols(columnOffset, region.columnCount)
+            .array();
+
+        auto yy = w.dySquaredResult.middleCols(columnOffset, region.columnCount)
+            .array();
+
+        auto xy = w.dxdyResult.middleCols(columnOffset, region.columnCount)
+            .array();
+
+        output.array() =
+            xx * yy - xy.square() - this->settings_.alpha * (xx + yy).square();
+    }
+
+    // The values listed from the response, and the largest value evaluated.
+    struct Listed
+    {
+        Float maximum;
+        typename Result::Maxima values;
+    };
+
+    /*
+     * Computes the response one region at a time, so that the products of
+     * the gradient, their windowed sums and the response stay in cache,
+     * and lists the values that may pass the threshold before moving on.
+     * No response larger than a region is kept.
+     *
+     * The threshold is relative to the largest value of every region, which
+     * is only known at the end. Each thread lists against the largest value
+     * it has seen so far, which is never above the final threshold, and
+     * drops what no longer passes whenever that value rises.
+     */
+    template<typename Derived>
+    Listed ListRegions_(
+        const Eigen::MatrixBase<Derived> &dx,
+        const Eigen::MatrixBase<Derived> &dy,
+        const std::vector<Region> &regions) const
+    {
+        using Eigen::Index;
+        using Maximum = typename Result::Maxima::value_type;
+
+        auto chunks = chunk::MakeThreadChunks(
+            this->settings_.threads,
+            static_cast<Index>(regions.size()));
+
+        std::vector<Listed> found(
+            chunks.size(),
+            Listed{std::numeric_limits<Float>::lowest(), {}});
+
+        chunk::RunChunks(
+            chunks,
+            [&](size_t chunkIndex)
+            {
+                auto &chunk = chunks[chunkIndex];
+                auto &listed = found[chunkIndex];
+                Workspace workspace;
+                Image response;
+                auto end = static_cast<size_t>(chunk.index + chunk.count);
+
+                for (
+                    auto index = static_cast<size_t>(chunk.index);
+                    index < end;
+                    ++index)
+                {
+                    auto &region = regions[index];
+
+                    if (region.rowCount < 1 || region.columnCount < 1)
+                    {
+                        continue;
+                    }
+
+                    response.resize(region.rowCount, region.columnCount);
+
+                    this->GetRegionResponse_(
+                        dx,
+                        dy,
+                        region,
+                        workspace,
+                        response);
+
+                    Float regionMaximum = response.maxCoeff();
+
+                    if (regionMaximum > listed.maximum)
+                    {
+                        listed.maximum = regionMaximum;
+                        Float floor = this->settings_.threshold * regionMaximum;
+
+                        std::erase_if(
+                            listed.values,
+                            [floor](const Maximum &maximum)
+                            {
+                                return maximum.value < floor;
+                            });
+                    }
+
+                    Float floor = this->settings_.threshold * listed.maximum;
+
+                    for (Index row = 0; row < region.rowCount; ++row)
+                    {
+                        for (
+                            Index column = 0;
+                            column < region.columnCount;
+                            ++column)
+                        {
+                            Float value = response(row, column);
+
+                            if (value >= floor && value != 0)
+                            {
+                                listed.values.push_back(
+                                    {column + region.column,
+                                        row + region.row,
+                                        value});
+                            }
+                        }
+                    }
+                }
+            });
+
+        Listed result{std::numeric_limits<Float>::lowest(), {}};
+
+        for (auto &listed: found)
+        {
+            result.maximum = std::max(result.maximum, listed.maximum);
+
+            result.values.insert(
+                result.values.end(),
+                listed.values.begin(),
+                listed.values.end());
+        }
+
+        return result;
+    }
+
+    // Drops the listed values below the threshold of the largest value.
+    void Threshold_(Listed &listed) const
+    {
+        using Maximum = typename Result::Maxima::value_type;
+
+        Float thresholdValue = this->settings_.threshold * listed.maximum;
+
+        std::erase_if(
+            listed.values,
+            [thresholdValue](const Maximum &maximum)
+            {
+                return maximum.value < thresholdValue;
+            });
+    }
+
+    static constexpr Eigen::Index bandBytes = 256 * 1024;
+
     HarrisSettings<Float> settings_;
     GaussianKernel<Float, Float, 0> gaussianKernel_;
 };
 
 
+extern template struct HarrisResult<float>;
+extern template class Harris<float>;
+
+extern template struct HarrisResult<double>;
+extern template class Harris<double>;
+
+
 template<typename Float>
 using ThreadsafeHarris =
     ThreadsafeFilter<HarrisGroup<Float>, Harris<Float>>;
 
 
+// Returns the intersections within the image of each pair of lines that
+// differ in angle by more than minimumAngle_deg, as candidates for
+// Harris::FilterCandidates.
+template<typename Float>
+std::vector<tau::Point2d<double>> GetIntersections(
+    const std::vector<tau::Line2d<Float>> &lines,
+    Eigen::Index rows,
+    Eigen::Index columns,
+    Float minimumAngle_deg)
+{
+    std::vector<tau::Point2d<double>> result;
+
+    for (size_t first = 0; first < lines.size(); ++first)
+    {
+        auto firstAngle = lines[first].GetAngleDegrees();
+
+        for (size_t second = first + 1; second < lines.size(); ++second)
+        {
+            if (tau::CompareLineAngles(
+                    firstAngle,
+                    lines[second].GetAngleDegrees(),
+                    minimumAngle_deg))
+            {
+                continue;
+            }
+
+            auto intersection = lines[first].Intersect(lines[second]);
+
+            bool isInImage =
+                intersection.x >= 0
+                && intersection.x < static_cast<Float>(columns)
+                && intersection.y >= 0
+                && intersection.y < static_cast<Float>(rows);
+
+            if (isInImage)
+            {
+                result.emplace_back(
+                    static_cast<double>(intersection.x),
+                    static_cast<double>(intersection.y));
+            }
+        }
+    }
+
+    return result;
+}
+
+
 template<typename Derived>
 std::shared_ptr<draw::Pixels> ColorizeHarris(
     const tau::Margins &margins,
@@ -153,4 +913,13 @@ std::shared_ptr<draw::Pixels> ColorizeHarris(
 }
 
 
+template<typename Float>
+std::shared_ptr<draw::Pixels> ColorizeHarris(
+    const tau::Margins &margins,
+    const HarrisResult<Float> &result)
+{
+    return ColorizeHarris(margins, result.GetResponse());
+}
+
+
 } // end namespace iris
@@ -0,0 +1,84 @@
+#include "iris/histogram.h"
+#include <cmath>
+
+
+namespace iris
+{
+
+
+Histogram::Histogram(size_t binCount)
+    :
+    counts(binCount, 0)
+{
+
+}
+
+
+size_t Histogram::GetBinCount() const
+{
+    return this->counts.size();
+}
+
+
+size_t Histogram::GetTotal(size_t firstBin) const
+{
+    size_t total = 0;
+
+    for (size_t bin = firstBin; bin < this->counts.size(); ++bin)
+    {
+        total += this->counts[bin];
+    }
+
+    return total;
+}
+
+
+void Histogram::Add(const Histogram &other)
+{
+    if (other.counts.size() != this->counts.size())
+    {
+        throw IrisError("Histograms must have the same bin count");
+    }
+
+    for (size_t bin = 0; bin < this->counts.size(); ++bin)
+    {
+        this->counts[bin] += other.counts[bin];
+    }
+}
+
+
+std::optional<size_t> Histogram::GetPercentile(
+    double percentile,
+    size_t firstBin) const
+{
+    auto total = this->GetTotal(firstBin);
+
+    if (total == 0)
+    {
+        return {};
+    }
+
+    percentile = std::max(0.0, std::min(1.0, percentile));
+
+    // The rank of the value in a sorted list of the counted values.
+    auto rank = static_cast<size_t>(
+        std::round(percentile * static_cast<double>(total - 1)));
+
+    size_t cumulative = 0;
+
+    for (size_t bin = firstBin; bin < this->counts.size(); ++bin)
+    {
+        cumulative += this->counts[bin];
+
+        if (cumulative > rank)
+        {
+            return bin;
+        }
+    }
+
+    // Unreachable: cumulative reaches total, and rank < total.
+    return this->counts.size() - 1;
+}
+
+
+} // end namespace iris
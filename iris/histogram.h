@@ -0,0 +1,119 @@
+#pragma once
+
+
+#include <algorithm>
+#include <cstddef>
+#include <optional>
+#include <vector>
+#include <jive/thread_pool.h>
+#include <tau/eigen.h>
+
+#include "iris/error.h"
+#include "iris/chunks.h"
+
+
+namespace iris
+{
+
+
+// Counts of bounded, non-negative integer values.
+class Histogram
+{
+public:
+    using Counts = std::vector<size_t>;
+
+    Histogram(size_t binCount);
+
+    size_t GetBinCount() const;
+
+    // The number of values counted in firstBin and above.
+    size_t GetTotal(size_t firstBin = 0) const;
+
+    void Add(const Histogram &other);
+
+    // Returns the bin of the value at the given percentile (0 to 1) of the
+    // values counted in firstBin and above, without interpolation.
+    // Returns nothing when there are no values.
+    std::optional<size_t> GetPercentile(
+        double percentile,
+        size_t firstBin = 0) const;
+
+    Counts counts;
+};
+
+
+// Builds a histogram from every stride-th row and column, with each thread
+// counting its own rows into a private histogram.
+// toBin(row, column) must return a bin less than binCount.
+template<typename ToBin>
+Histogram MakeHistogram(
+    size_t binCount,
+    Eigen::Index rows,
+    Eigen::Index columns,
+    size_t threads,
+    Eigen::Index stride,
+    const ToBin &toBin)
+{
+    using Eigen::Index;
+
+    if (stride < 1)
+    {
+        throw IrisError("stride must be at least 1");
+    }
+
+    Histogram result(binCount);
+
+    Index sampledRows = (rows + stride - 1) / stride;
+
+    if (sampledRows == 0 || columns == 0)
+    {
+        return result;
+    }
+
+    auto threadCount = static_cast<size_t>(
+        std::clamp(static_cast<Index>(threads), Index{1}, sampledRows));
+
+    auto chunks = chunk::MakeChunks(threadCount, sampledRows);
+
+    std::vector<Histogram> histograms(chunks.size(), Histogram(binCount));
+    std::vector<jive::Sentry> threadSentries;
+    threadSentries.reserve(chunks.size());
+    auto threadPool = jive::GetThreadPool();
+
+    for (auto index: jive::Range<size_t>(0, chunks.size()))
+    {
+        threadSentries.emplace_back(
+            threadPool->AddJob(
+                [&, index]()
+                {
+                    auto &chunk = chunks[index];
+                    auto &counts = histograms[index].counts;
+                    Index end = chunk.index + chunk.count;
+
+                    for (Index sample = chunk.index; sample < end; ++sample)
+                    {
+                        Index row = sample * stride;
+
+                        for (
+                            Index column = 0;
+                            column < columns;
+                            column += stride)
+                        {
+                            ++counts[toBin(row, column)];
+                        }
+                    }
+                }));
+    }
+
+    chunk::AwaitThreads(threadSentries);
+
+    for (auto &histogram: histograms)
+    {
+        result.Add(histogram);
+    }
+
+    return result;
+}
+
+
+} // end namespace iris
@@ -0,0 +1,24 @@
+#include "iris/hough.h"
+
+
+namespace iris
+{
+
+
+template struct HoughResult<double>;
+template class Hough<double>;
+
+template struct HoughResult<double, uint16_t>;
+template class Hough<double, uint16_t>;
+
+template struct HoughResult<double, uint32_t>;
+template class Hough<double, uint32_t>;
+
+template struct HoughResult<float>;
+template class Hough<float>;
+
+template struct HoughResult<float, uint32_t>;
+template class Hough<float, uint32_t>;
+
+
+} // end namespace iris
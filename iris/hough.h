@@ -1,7 +1,17 @@
 #pragma once
 
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <future>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <type_traits>
 #include <vector>
 #include <tau/eigen.h>
 #include <tau/stack.h>
@@ -13,37 +23,53 @@
 #include "iris/hough_settings.h"
 #include "iris/canny.h"
 #include "iris/chunks.h"
-#include "iris/suppression.h"
 
 
 namespace iris
 {
 
 
-template<typename Float>
+// Count is the type of the vote space.
+// Integral counts saturate instead of overflowing, and weighted votes are
+// stored in fixed point with up to HoughSettings::weightScale counts per
+// unit weight.
+// The space is indexed by (rho, theta), and it is row-major, so the votes
+// of one point at neighbouring thetas share cache lines wherever its rho
+// changes slowly.
+template<typename Float, typename Count = Float>
 struct HoughResult
 {
     using Lines = std::vector<tau::Line2d<Float>>;
 
     using Matrix =
-        Eigen::Matrix<Float, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+        Eigen::Matrix<Count, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
 
-    Matrix space;
+    // The space is shared with the accumulator, which votes into a new
+    // space for the next frame while a result still holds this one.
+    std::shared_ptr<const Matrix> space;
     Lines lines;
 
     template<typename Value>
     tau::MatrixLike<Value, Matrix> GetScaledSpace(Float targetMaximum) const
     {
-        auto maximum = this->space.maxCoeff();
+        if (!this->space)
+        {
+            return {};
+        }
+
+        auto &space = *this->space;
+        auto maximum = static_cast<Float>(space.maxCoeff());
 
         if (maximum < Float(1))
         {
             return tau::MatrixLike<Value, Matrix>::Zero(
-                this->space.rows(),
-                this->space.cols());
+                space.rows(),
+                space.cols());
         }
 
-        auto scaled = (this->space.array() * targetMaximum / maximum)
+        auto scaled =
+            (space.template cast<Float>().array()
+                * targetMaximum / maximum)
                 .floor().template cast<Value>();
 
         return scaled;
@@ -51,122 +77,129 @@ struct HoughResult
 };
 
 
+// The difference between two line orientations in degrees, from 0 to 90.
 template<typename Float>
-struct EdgePoint
+Float GetOrientationDifference(Float first, Float second)
 {
-    using Index = typename Eigen::Index;
-    Index row;
-    Index column;
-    Float weight;
-    Float phase;
-
-    tau::Point2d<Index> GetPoint2d() const
-    {
-        return {this->column, this->row};
-    }
-};
+    return std::abs(
+        std::fmod(first - second + Float(630), Float(180)) - Float(90));
+}
 
 
+// Finds the strongest edge orientations from a histogram of the phases
+// modulo 180 degrees, with one bin per degree.
+// Each mode is the mean of the modeWidth-wide window with the most edges,
+// and modes are at least 2 * modeWidth apart, so bands of modeWidth on
+// either side of them do not overlap.
 template<typename Float>
-using EdgePoints = std::vector<EdgePoint<Float>>;
-
-
-template<typename Data, typename Float>
-class WeightedEdgeMaker
+std::vector<Float> FindOrientationModes(
+    const CannyEdges &edges,
+    size_t modeCount,
+    Float modeWidth,
+    bool weighted)
 {
-public:
-    using Phase = typename Phasor<Float>::Matrix;
+    using Index = Eigen::Index;
 
-    WeightedEdgeMaker(
-        Eigen::MatrixBase<Data> &&edges,
-        Phase &&phase) = delete;
+    static constexpr Index binCount = 180;
 
-    WeightedEdgeMaker(
-        const Eigen::MatrixBase<Data> &edges,
-        const Phase &phase)
-        :
-        edges_(edges),
-        phase_(phase)
+    Eigen::VectorX<Float> histogram = Eigen::VectorX<Float>::Zero(binCount);
+
+    for (size_t i = 0; i < edges.size(); ++i)
     {
+        auto bin = std::min(
+            binCount - 1,
+            static_cast<Index>(std::fmod(edges.phases[i], 180.0f)));
 
+        histogram(bin) += (weighted)
+            ? static_cast<Float>(edges.weights[i])
+            : Float(1);
     }
 
-    EdgePoint<Float> operator()(Eigen::Index row, Eigen::Index column)
+    // Sum each window, wrapping from 180 to 0.
+    auto halfWidth = static_cast<Index>(std::round(modeWidth / 2));
+    Eigen::VectorX<Float> windows = Eigen::VectorX<Float>::Zero(binCount);
+
+    for (Index bin = 0; bin < binCount; ++bin)
     {
-        return {
-            row,
-            column,
-            this->edges_(row, column),
-            this->phase_(row, column)};
+        for (Index offset = -halfWidth; offset <= halfWidth; ++offset)
+        {
+            windows(bin) +=
+                histogram((bin + offset + binCount) % binCount);
+        }
     }
 
-protected:
-    const Eigen::MatrixBase<Data> & edges_;
-    const Phase & phase_;
-};
-
+    std::vector<Float> result;
 
-template<typename Data, typename Float>
-class EdgeMaker: public WeightedEdgeMaker<Data, Float>
-{
-public:
-    using Base = WeightedEdgeMaker<Data, Float>;
-    using Base::Base;
-
-    EdgePoint<Float> operator()(Eigen::Index row, Eigen::Index column)
+    while (result.size() < modeCount)
     {
-        return {
-            row,
-            column,
-            1,
-            this->phase_(row, column)};
-    }
-};
+        Index peak;
+        auto count = windows.maxCoeff(&peak);
+
+        if (count <= 0)
+        {
+            break;
+        }
 
+        // Windows that hold the same edges tie, and the first is found, so
+        // the mode is moved to the mean of the bins in the window.
+        Float offsetSum = 0;
 
-template
-<
-    template<typename, typename> typename EdgeFunctor,
-    typename Data,
-    typename Float
->
-EdgePoints<Float> MakeEdgePoints(
-    const Eigen::MatrixBase<Data> &edges,
-    const Phasor<Float> &phasor)
-{
-    using Eigen::Index;
-    EdgePoints<Float> result;
+        for (Index offset = -halfWidth; offset <= halfWidth; ++offset)
+        {
+            offsetSum += static_cast<Float>(offset)
+                * histogram((peak + offset + binCount) % binCount);
+        }
 
-    result.reserve(
-        static_cast<size_t>((edges.array() > 0).count()));
+        auto mode = std::fmod(
+            static_cast<Float>(peak) + offsetSum / count + Float(180.5),
+            Float(180));
 
-    EdgeFunctor<Data, Float> edgeFunctor(edges, phasor.phase);
+        result.push_back(mode);
 
-    if constexpr (tau::MatrixTraits<Data>::isColumnMajor)
-    {
-        for (Index column = 0; column < edges.cols(); ++column)
+        for (Index bin = 0; bin < binCount; ++bin)
         {
-            for (Index row = 0; row < edges.rows(); ++row)
+            auto center = static_cast<Float>(bin) + Float(0.5);
+
+            if (GetOrientationDifference(center, mode) < 2 * modeWidth)
             {
-                if (edges(row, column) > 0)
-                {
-                    result.push_back(edgeFunctor(row, column));
-                }
+                windows(bin) = 0;
             }
         }
     }
-    else
+
+    return result;
+}
+
+
+// Returns the edges with a phase within modeWidth of one of the modes.
+template<typename Float>
+CannyEdges SelectOrientationEdges(
+    const CannyEdges &edges,
+    const std::vector<Float> &modes,
+    Float modeWidth)
+{
+    CannyEdges result;
+    result.reserve(edges.size());
+
+    for (size_t i = 0; i < edges.size(); ++i)
     {
-        // row major
-        for (Index row = 0; row < edges.rows(); ++row)
-        {
-            for (Index column = 0; column < edges.cols(); ++column)
+        auto phase = static_cast<Float>(edges.phases[i]);
+
+        auto isSelected = std::any_of(
+            std::begin(modes),
+            std::end(modes),
+            [&](Float mode)
             {
-                if (edges(row, column) > 0)
-                {
-                    result.push_back(edgeFunctor(row, column));
-                }
-            }
+                return GetOrientationDifference(phase, mode) <= modeWidth;
+            });
+
+        if (isSelected)
+        {
+            result.PushBack(
+                edges.rows[i],
+                edges.columns[i],
+                edges.weights[i],
+                edges.phases[i]);
         }
     }
 
@@ -174,20 +207,62 @@ EdgePoints<Float> MakeEdgePoints(
 }
 
 
-template<typename Float>
+template<typename Float, typename Count = Float>
 class Hough
 {
 public:
-    using Result = HoughResult<Float>;
+    using Result = HoughResult<Float, Count>;
     using Matrix = typename Result::Matrix;
     using Index = Eigen::Index;
 
+    // Holds the trigonometry tables and the vote space for one set of
+    // settings.
+    // The space is shared by the worker threads, each of which votes into
+    // its own range of theta columns, a slice of every row, so no reduction
+    // is needed.
+    // An accumulator is used by one call to Filter at a time.
     class Accumulator
     {
     public:
         using RowVector = Eigen::RowVectorX<Float>;
+        using FixedTable = std::vector<int32_t>;
+
+        // A cell of the space with a count above the threshold.
+        struct Peak
+        {
+            Index rho;
+            Index theta;
+            Count count;
+
+            // Orders by count, preferring the lower theta, then the lower
+            // rho, when the counts are equal.
+            bool operator<(const Peak &other) const
+            {
+                if (this->count != other.count)
+                {
+                    return this->count < other.count;
+                }
+
+                if (this->theta != other.theta)
+                {
+                    return this->theta > other.theta;
+                }
+
+                return this->rho > other.rho;
+            }
+        };
+
+        using Peaks = std::vector<Peak>;
+
+        // Ranges of theta columns that receive votes.
+        using ThetaBands = std::vector<chunk::Chunk>;
+
+        // Rho indices are computed in blocks of this many thetas.
+        static constexpr Index kernelWidth = 64;
 
-        Accumulator() = default;
+        // Weighted integral counts can hold lines this many times stronger
+        // than the threshold before they saturate.
+        static constexpr Float thresholdHeadroom = 8;
 
         static Float GetToIndexFactor(Index rhoCount, Float maximumRho)
         {
@@ -198,157 +273,388 @@ public:
             return maximumRhoIndex / (2 * maximumRho);
         }
 
-        Accumulator(
-                const draw::Size &imageSize,
-                size_t rhoCount,
-                size_t thetaCount,
-                Float angleRange)
-#if 0
+        // The most fraction bits that keep every fixed-point rho index
+        // within int32_t, with one bit of headroom.
+        static int GetFixedShift(Index rhoCount)
+        {
+            int shift = 30;
+
+            while (
+                shift > 0
+                && ((rhoCount + 1) << (shift + 1))
+                    > std::numeric_limits<int32_t>::max())
+            {
+                --shift;
+            }
+
+            return shift;
+        }
+
+        Accumulator(const HoughSettings<Float> &settings)
             :
-            center_(imageSize.ToPoint2d().template Cast<Float>() / 2),
+            width_(static_cast<int32_t>(settings.imageSize.width)),
+            height_(static_cast<int32_t>(settings.imageSize.height)),
+            center_(
+                settings.imageSize.ToPoint2d().template Cast<Float>() / 2),
             maximumRho_(this->center_.Magnitude()),
-            rhoCount_(static_cast<Index>(rhoCount)),
+            rhoCount_(static_cast<Index>(settings.rhoCount)),
 
             toIndexFactor_(
                 GetToIndexFactor(this->rhoCount_, this->maximumRho_)),
 
-            thetaCount_(static_cast<Index>(thetaCount)),
-            angleRange_(angleRange),
+            thetaCount_(static_cast<Index>(settings.thetaCount)),
+            angleRange_(settings.angleRange),
             thetas_(
                 RowVector::LinSpaced(
                     this->thetaCount_,
                     static_cast<Float>(0),
                     static_cast<Float>(tau::Angles<Float>::pi))),
-            sinesAndCosines_(
-                tau::VerticalStack(
-                    this->thetas_.array().sin().eval(),
-                    this->thetas_.array().cos().eval())),
-            space_(
-                Matrix::Zero(
-                    static_cast<Index>(rhoCount),
-                    static_cast<Index>(thetaCount)))
-#endif
+            fixedShift_(GetFixedShift(this->rhoCount_)),
+            fixedSines_(),
+            fixedCosines_(),
+            fixedOffset_(),
+            weighted_(settings.weighted),
+            weightScale_(GetWeightScale(settings)),
+            threshold_(),
+            space_(),
+            bucketSize_(),
+            bucketRows_(),
+            bucketColumns_(),
+            buckets_(),
+            isSaturated_(false),
+            hasStream_(false),
+            streamEdges_(),
+            streamBands_()
         {
-            this->Initialize(imageSize, rhoCount, thetaCount, angleRange);
+            this->threshold_ = this->ToCountThreshold(settings.threshold);
+
+            // Points are doubled so that they can be centered on a
+            // half-pixel in integers, so the tables are scaled by half.
+            auto unit = static_cast<Float>(int64_t{1} << this->fixedShift_);
+            auto scale = unit * this->toIndexFactor_ / 2;
+
+            this->fixedSines_.reserve(static_cast<size_t>(this->thetaCount_));
+            this->fixedCosines_.reserve(static_cast<size_t>(this->thetaCount_));
+
+            for (auto theta: this->thetas_)
+            {
+                this->fixedSines_.push_back(
+                    static_cast<int32_t>(std::round(std::sin(theta) * scale)));
+
+                this->fixedCosines_.push_back(
+                    static_cast<int32_t>(std::round(std::cos(theta) * scale)));
+            }
+
+            // Shift rho to the positive, and add one half so that the
+            // truncating shift rounds to the nearest index.
+            this->fixedOffset_ = static_cast<int32_t>(
+                std::round(
+                    (this->maximumRho_ * this->toIndexFactor_ + Float(0.5))
+                    * unit));
         }
 
-        void Initialize(
-                const draw::Size &imageSize,
-                size_t rhoCount,
-                size_t thetaCount,
-                Float angleRange)
+        // The number of counts for a vote with a weight of 1.
+        // The scale is limited so that the threshold, in counts, leaves
+        // thresholdHeadroom for stronger lines in narrow counts.
+        static Float GetWeightScale(const HoughSettings<Float> &settings)
         {
-            this->center_ = imageSize.ToPoint2d().template Cast<Float>() / 2;
-            this->maximumRho_ = this->center_.Magnitude();
-            this->rhoCount_ = static_cast<Index>(rhoCount);
+            if constexpr (std::is_integral_v<Count>)
+            {
+                if (settings.weighted)
+                {
+                    auto limit =
+                        static_cast<Float>(std::numeric_limits<Count>::max())
+                        / (thresholdHeadroom
+                            * std::max(
+                                Float(1),
+                                static_cast<Float>(settings.threshold)));
+
+                    return std::max(
+                        Float(1),
+                        std::min(settings.weightScale, limit));
+                }
+            }
 
-            this->toIndexFactor_ =
-                GetToIndexFactor(this->rhoCount_, this->maximumRho_);
+            return Float(1);
+        }
 
-            this->thetaCount_ = static_cast<Index>(thetaCount);
-            this->angleRange_ = angleRange;
+        Count ToVote(float weight) const
+        {
+            if (!this->weighted_)
+            {
+                return Count(1);
+            }
 
-            this->thetas_ =
-                RowVector::LinSpaced(
-                    this->thetaCount_,
-                    static_cast<Float>(0),
-                    static_cast<Float>(tau::Angles<Float>::pi));
+            if constexpr (std::is_integral_v<Count>)
+            {
+                auto vote = std::round(
+                    static_cast<Float>(weight) * this->weightScale_);
+
+                return static_cast<Count>(
+                    std::min(
+                        vote,
+                        static_cast<Float>(
+                            std::numeric_limits<Count>::max())));
+            }
+            else
+            {
+                return static_cast<Count>(weight);
+            }
+        }
 
-            this->sinesAndCosines_ =
-                tau::VerticalStack(
-                    this->thetas_.array().sin().eval(),
-                    this->thetas_.array().cos().eval());
+        // Converts the threshold to counts.
+        // A count is above the threshold when it is greater than the result.
+        Count ToCountThreshold(Float threshold) const
+        {
+            if constexpr (std::is_integral_v<Count>)
+            {
+                auto scaled = std::floor(threshold * this->weightScale_);
 
-            this->space_ =
-                Matrix::Zero(
-                    static_cast<Index>(rhoCount),
-                    static_cast<Index>(thetaCount));
+                return static_cast<Count>(
+                    std::min(
+                        scaled,
+                        static_cast<Float>(
+                            std::numeric_limits<Count>::max())));
+            }
+            else
+            {
+                return static_cast<Count>(threshold);
+            }
         }
 
-        void AddPoint_(
-            tau::Point2d<Float> &centeredPoint,
-            Float weight,
-            Float lowAngle,
-            Float highAngle)
+        // Votes every edge into the theta columns of the chunk, then
+        // appends the cells of those columns that exceed the threshold to
+        // peaks.
+        // The columns are cleared first, so the space can be reused for the
+        // next frame without reallocating.
+        void Vote(
+            const CannyEdges &edges,
+            const ThetaBands &bands,
+            const chunk::Chunk &columns,
+            Peaks &peaks)
         {
-            // Lookup indices.
-            Index lowIndex = this->ToThetaIndex(lowAngle);
-            Index highIndex = this->ToThetaIndex(highAngle);
-            Index thetaCount = highIndex - lowIndex;
+            this->space_->middleCols(columns.index, columns.count).setZero();
+            this->AddEdges_<false>(edges, bands, columns);
+            this->CollectPeaks_(columns, peaks);
+        }
+
+        // Removes the votes of edges that left the scene and adds the votes
+        // of new edges, leaving the rest of the previous frame's votes.
+        void Update(
+            const CannyEdges &removed,
+            const CannyEdges &added,
+            const ThetaBands &bands,
+            const chunk::Chunk &columns,
+            Peaks &peaks)
+        {
+            this->AddEdges_<true>(removed, bands, columns);
+            this->AddEdges_<false>(added, bands, columns);
+            this->CollectPeaks_(columns, peaks);
+        }
+
+        // Compares edges to the edges of the previous frame, which were
+        // voted into the same bands.
+        // Returns true and fills added and removed when the difference
+        // is at most limit times the number of edges. Otherwise, the space
+        // must be voted again.
+        bool Difference(
+            const CannyEdges &edges,
+            const ThetaBands &bands,
+            Float limit,
+            CannyEdges &added,
+            CannyEdges &removed)
+        {
+            auto order = SortByPosition(edges);
+            bool isComparable = this->hasStream_ && bands == this->streamBands_;
+
+            auto maximumCount = static_cast<size_t>(
+                limit * static_cast<Float>(edges.size()));
 
-            if (thetaCount == 0)
+            const auto &previous = this->streamEdges_;
+            size_t previousIndex = 0;
+
+            auto getKey = [](const CannyEdges &list, size_t index)
             {
-                return;
-            }
+                return (uint32_t{list.rows[index]} << 16)
+                    | uint32_t{list.columns[index]};
+            };
+
+            auto isSame = [&](size_t index, size_t other)
+            {
+                return edges.weights[index] == previous.weights[other]
+                    && edges.phases[index] == previous.phases[other];
+            };
+
+            auto copy = [](
+                CannyEdges &target,
+                const CannyEdges &source,
+                size_t index)
+            {
+                target.PushBack(
+                    source.rows[index],
+                    source.columns[index],
+                    source.weights[index],
+                    source.phases[index]);
+            };
+
+            CannyEdges sorted;
+            sorted.reserve(edges.size());
 
-            // rho = x * cosine(theta) + y * sine(theta)
-            Eigen::RowVector<Float, 2> pointVector(
-                centeredPoint.y,
-                centeredPoint.x);
+            for (auto index: order)
+            {
+                copy(sorted, edges, index);
+
+                if (!isComparable)
+                {
+                    continue;
+                }
 
-            // Compute rho only for the selected angle range.
-            RowVector rhos = pointVector
-                * this->sinesAndCosines_.block(0, lowIndex, 2, thetaCount);
+                auto key = getKey(edges, index);
+
+                while (
+                    previousIndex < previous.size()
+                    && getKey(previous, previousIndex) < key)
+                {
+                    copy(removed, previous, previousIndex++);
+                }
 
-            assert(rhos.cols() == thetaCount);
-            assert(rhos.maxCoeff() <= this->maximumRho_);
+                if (
+                    previousIndex < previous.size()
+                    && getKey(previous, previousIndex) == key)
+                {
+                    if (!isSame(index, previousIndex))
+                    {
+                        copy(removed, previous, previousIndex);
+                        copy(added, edges, index);
+                    }
+
+                    ++previousIndex;
+                }
+                else
+                {
+                    copy(added, edges, index);
+                }
 
-            auto indices = this->ToRhoIndex(rhos);
+                if (added.size() + removed.size() > maximumCount)
+                {
+                    isComparable = false;
+                }
+            }
 
-            assert(indices.cols() == thetaCount);
-            assert(lowIndex + thetaCount <= this->space_.cols());
-            assert(indices.maxCoeff() < this->space_.rows());
+            while (isComparable && previousIndex < previous.size())
+            {
+                copy(removed, previous, previousIndex++);
+            }
 
-            for (Index i = 0; i < thetaCount; ++i)
+            if (added.size() + removed.size() > maximumCount)
             {
-                this->space_(indices(i), lowIndex + i) += weight;
+                isComparable = false;
             }
+
+            this->streamEdges_ = std::move(sorted);
+            this->streamBands_ = bands;
+            this->hasStream_ = true;
+
+            return isComparable;
+        }
+
+        // Forgets the previous frame, so the next Difference fails.
+        void ResetStream()
+        {
+            this->isSaturated_ = false;
+            this->hasStream_ = false;
+            this->streamEdges_ = CannyEdges{};
+        }
+
+        // Whether a cell has saturated since the stream was reset.
+        // The votes of a saturated cell cannot be removed exactly, so the
+        // space must be voted again.
+        bool IsSaturated() const
+        {
+            return this->isSaturated_;
         }
 
-        void AddPoint(
+        // The order of the edges by row, then column.
+        static std::vector<size_t> SortByPosition(const CannyEdges &edges)
+        {
+            std::vector<size_t> result(edges.size());
+            std::iota(std::begin(result), std::end(result), size_t{0});
+
+            std::sort(
+                std::begin(result),
+                std::end(result),
+                [&](size_t first, size_t second)
+                {
+                    if (edges.rows[first] != edges.rows[second])
+                    {
+                        return edges.rows[first] < edges.rows[second];
+                    }
+
+                    return edges.columns[first] < edges.columns[second];
+                });
+
+            return result;
+        }
+
+        // Returns true when a cell saturated.
+        template<bool isRemoval = false>
+        bool AddPoint(
             tau::Point2d<Index> pointIndex,
-            Float weight,
-            Float angle)
+            Count vote,
+            Float angle,
+            Index firstColumn,
+            Index endColumn)
         {
-            auto point = pointIndex.template Cast<Float>();
-            point -= this->center_;
+            // The doubled offset from the center of the image.
+            auto point = tau::Point2d<int32_t>(
+                static_cast<int32_t>(2 * pointIndex.x) - this->width_,
+                static_cast<int32_t>(2 * pointIndex.y) - this->height_);
 
             angle = std::fmod(angle, static_cast<Float>(180));
             Float lowAngle = angle - this->angleRange_;
             Float highAngle = angle + this->angleRange_;
+            bool isSaturated = false;
+
+            auto addPoint = [&](Float low, Float high)
+            {
+                isSaturated |= this->AddPoint_<isRemoval>(
+                    point,
+                    vote,
+                    low,
+                    high,
+                    firstColumn,
+                    endColumn);
+            };
 
             // Handle wrap at 0 and 180.
             if (lowAngle < 0)
             {
-                this->AddPoint_(point, weight, lowAngle + 180, 180);
-                this->AddPoint_(point, weight, 0, angle);
+                addPoint(lowAngle + 180, 180);
+                addPoint(0, angle);
             }
             else
             {
-                this->AddPoint_(point, weight, lowAngle, angle);
+                addPoint(lowAngle, angle);
             }
 
             if (highAngle > 180)
             {
-                this->AddPoint_(point, weight, 0, highAngle - 180);
-                this->AddPoint_(point, weight, angle, 180);
+                addPoint(0, highAngle - 180);
+                addPoint(angle, 180);
             }
             else
             {
-                this->AddPoint_(point, weight, angle, highAngle);
+                addPoint(angle, highAngle);
             }
 
+            return isSaturated;
         }
 
-        template<typename Derived>
-        auto ToRhoIndex(const Eigen::MatrixBase<Derived> &rho) const
-            -> tau::MatrixLike<Index, Derived>
+        Index ToRhoIndex(Float rho) const
         {
             // Shift rho values to the positive.
-
-            return ((rho.array() + this->maximumRho_) * this->toIndexFactor_)
-                .round()
-                .template cast<Index>();
+            return static_cast<Index>(
+                std::round((rho + this->maximumRho_) * this->toIndexFactor_));
         }
 
         Float ToRho(Index index) const
@@ -369,145 +675,486 @@ public:
             return this->thetas_(index);
         }
 
-        const Matrix & GetSpace() const
+        Index GetThetaCount() const
         {
-            return this->space_;
+            return this->thetaCount_;
         }
 
-        void SetSpace(const Matrix &space)
+        // Every theta column.
+        ThetaBands GetAllThetas() const
         {
-            this->space_ = space;
+            return {chunk::Chunk{0, this->thetaCount_}};
         }
 
-        void GetLinesWithEdges(
-            std::vector<tau::Line2d<Float>> &result,
-            const HoughSettings<Float> &settings)
+        // The columns within width degrees of each mode, wrapping from 180
+        // to 0.
+        ThetaBands GetThetaBands(
+            const std::vector<Float> &modes,
+            Float width) const
         {
-            auto threshold = settings.threshold;
+            if (width >= 90)
+            {
+                return this->GetAllThetas();
+            }
 
-            for (
-                Index rowIndex = 0;
-                rowIndex < this->space_.rows();
-                ++rowIndex)
-            {
-                for (
-                    Index columnIndex = 0;
-                    columnIndex < this->space_.cols();
-                    ++columnIndex)
+            ThetaBands result;
+
+            auto addBand = [&](Float low, Float high)
+            {
+                Index first = this->ToThetaIndex(low);
+                Index end = this->ToThetaIndex(high);
+
+                if (end > first)
                 {
-                    if (this->space_(rowIndex, columnIndex) > threshold)
-                    {
-                        auto rho = this->ToRho(rowIndex);
+                    result.push_back({first, end - first});
+                }
+            };
 
-                        auto degrees =
-                            tau::ToDegrees(this->ToTheta(columnIndex));
+            for (auto mode: modes)
+            {
+                Float low = mode - width;
+                Float high = mode + width;
 
-                        result.emplace_back(rho, degrees);
-                    }
+                if (low < 0)
+                {
+                    addBand(low + 180, 180);
+                    addBand(0, high);
+                }
+                else if (high > 180)
+                {
+                    addBand(low, 180);
+                    addBand(0, high - 180);
+                }
+                else
+                {
+                    addBand(low, high);
                 }
             }
+
+            return result;
         }
 
-        void GetLinesWithoutEdges(
-            std::vector<tau::Line2d<Float>> &result,
-            const HoughSettings<Float> &settings)
+        // The distance in pixels between adjacent rho indices.
+        Float GetRhoStep() const
+        {
+            return Float(1) / this->toIndexFactor_;
+        }
+
+        // Allocates the space on first use, and again when a result still
+        // holds the previous space. An update keeps the previous votes.
+        // Otherwise, the contents are undefined until every column has
+        // been voted.
+        void Prepare(bool isUpdate)
+        {
+            if (!this->space_)
+            {
+                this->space_ = std::make_shared<Matrix>(
+                    this->rhoCount_,
+                    this->thetaCount_);
+            }
+            else if (this->space_.use_count() > 1)
+            {
+                this->space_ = (isUpdate)
+                    ? std::make_shared<Matrix>(*this->space_)
+                    : std::make_shared<Matrix>(
+                        this->rhoCount_,
+                        this->thetaCount_);
+            }
+        }
+
+        std::shared_ptr<const Matrix> GetSpace() const
+        {
+            return this->space_;
+        }
+
+        // Whether two cells are within a window of each other.
+        // The space wraps from 180 degrees to 0, where rho changes sign.
+        bool IsNear(const Peak &first, const Peak &second, Index window) const
+        {
+            Index thetaDistance = std::abs(first.theta - second.theta);
+
+            if (thetaDistance < window)
+            {
+                return std::abs(first.rho - second.rho) < window;
+            }
+
+            // The first and last theta are both 0 degrees.
+            Index period = this->thetaCount_ - 1;
+
+            if (period - thetaDistance < window)
+            {
+                Index mirroredRho = this->rhoCount_ - 1 - second.rho;
+
+                return std::abs(first.rho - mirroredRho) < window;
+            }
+
+            return false;
+        }
+
+        // Lines at the image border are usually produced by the edge of
+        // the image, and not by the scene.
+        bool IsImageEdge(
+            Float rho,
+            Float degrees,
+            const HoughSettings<Float> &settings) const
         {
             auto verticalLimit = settings.imageSize.height / 2;
             auto horizontalLimit = settings.imageSize.width / 2;
             auto tolerance = settings.edgeTolerance;
-            auto threshold = settings.threshold;
 
-            for (
-                Index rowIndex = 0;
-                rowIndex < this->space_.rows();
-                ++rowIndex)
-            {
-                for (
-                    Index columnIndex = 0;
-                    columnIndex < this->space_.cols();
-                    ++columnIndex)
+            auto rhoCheck = std::abs(rho);
+
+            // degrees has the range 0 to 180.
+            auto verticalCheck = std::abs(degrees - 90);
+
+            if (
+                verticalCheck < 0.5
+                && std::abs(rhoCheck - verticalLimit) < tolerance)
+            {
+                return true;
+            }
+
+            // Remap degrees from -90 to 90
+            auto remapped = std::fmod(degrees + 270, 180) - 90;
+            auto horizontalCheck = std::abs(remapped);
+
+            return (
+                horizontalCheck < 0.5
+                && std::abs(rhoCheck - horizontalLimit) < tolerance);
+        }
+
+        // Takes peaks from the strongest down until maximumLines have been
+        // found, or every peak when maximumLines is 0.
+        // When suppress is set, a peak is discarded if a stronger peak lies
+        // within the window, like a full-frame window suppression would.
+        std::vector<tau::Line2d<Float>> GetLines(
+            Peaks &peaks,
+            const HoughSettings<Float> &settings)
+        {
+            std::vector<tau::Line2d<Float>> result{};
+
+            std::make_heap(std::begin(peaks), std::end(peaks));
+
+            auto window = settings.window;
+            this->ResetBuckets_(window);
+
+            auto maximumLines = (settings.maximumLines > 0)
+                ? settings.maximumLines
+                : peaks.size();
+
+            while (!peaks.empty() && result.size() < maximumLines)
+            {
+                std::pop_heap(std::begin(peaks), std::end(peaks));
+                Peak peak = peaks.back();
+                peaks.pop_back();
+
+                if (settings.suppress)
                 {
-                    if (this->space_(rowIndex, columnIndex) <= threshold)
+                    // Suppressed peaks and peaks at the image edge still
+                    // suppress their weaker neighbors.
+                    bool isSuppressed = this->HasNeighbor_(peak, window);
+                    this->AddToBucket_(peak);
+
+                    if (isSuppressed)
                     {
                         continue;
                     }
+                }
+
+                auto rho = this->ToRho(peak.rho);
+                auto degrees = tau::ToDegrees(this->ToTheta(peak.theta));
+
+                if (
+                    !settings.includeEdges
+                    && this->IsImageEdge(rho, degrees, settings))
+                {
+                    continue;
+                }
+
+                result.emplace_back(rho, degrees);
+            }
+
+            // Shift the lines so they are relative to the image origin.
+            for (auto &line: result)
+            {
+                line.point += this->center_;
+            }
 
-                    auto rho = this->ToRho(rowIndex);
+            return result;
+        }
 
-                    auto rhoCheck = std::abs(rho);
+    private:
+        // Peaks are sorted into window-sized buckets, so each peak is only
+        // compared with the peaks in the neighboring buckets.
+        void ResetBuckets_(Index window)
+        {
+            Index bucketRows = (this->rhoCount_ + window - 1) / window;
+            Index bucketColumns = (this->thetaCount_ + window - 1) / window;
 
-                    auto degrees =
-                        tau::ToDegrees(this->ToTheta(columnIndex));
+            this->bucketSize_ = window;
+            this->bucketRows_ = bucketRows;
+            this->bucketColumns_ = bucketColumns;
 
-                    // degrees has the range 0 to 180.
-                    auto verticalCheck = std::abs(degrees - 90);
+            this->buckets_.resize(
+                static_cast<size_t>(bucketRows * bucketColumns));
 
-                    if (
-                        verticalCheck < 0.5
-                        && std::abs(rhoCheck - verticalLimit) < tolerance)
-                    {
-                        continue;
-                    }
+            // Keep the capacity of each bucket for the next frame.
+            for (auto &bucket: this->buckets_)
+            {
+                bucket.clear();
+            }
+        }
+
+        void AddToBucket_(const Peak &peak)
+        {
+            auto &bucket = this->GetBucket_(
+                peak.rho / this->bucketSize_,
+                peak.theta / this->bucketSize_);
+
+            bucket.push_back(peak);
+        }
+
+        Peaks & GetBucket_(Index bucketRow, Index bucketColumn)
+        {
+            return this->buckets_[
+                static_cast<size_t>(
+                    bucketColumn * this->bucketRows_ + bucketRow)];
+        }
+
+        // Searches the buckets around (rho, theta), which may be outside of
+        // the theta range when checking across the seam.
+        bool SearchBuckets_(
+            const Peak &peak,
+            Index rho,
+            Index theta,
+            Index window)
+        {
+            // theta is negative when checking across the seam from 0.
+            Index bucketRow = rho / window;
+
+            Index bucketColumn = (theta < 0)
+                ? -((window - 1 - theta) / window)
+                : theta / window;
+
+            Index firstRow = std::max(Index{0}, bucketRow - 1);
+            Index lastRow = std::min(this->bucketRows_ - 1, bucketRow + 1);
 
-                    // Remap degrees from -90 to 90
-                    auto remapped = std::fmod(degrees + 270, 180) - 90;
-                    auto horizontalCheck = std::abs(remapped);
+            Index firstColumn = std::max(Index{0}, bucketColumn - 1);
 
-                    if (
-                        horizontalCheck < 0.5
-                        && std::abs(rhoCheck - horizontalLimit) < tolerance)
+            Index lastColumn =
+                std::min(this->bucketColumns_ - 1, bucketColumn + 1);
+
+            for (Index column = firstColumn; column <= lastColumn; ++column)
+            {
+                for (Index row = firstRow; row <= lastRow; ++row)
+                {
+                    for (auto &other: this->GetBucket_(row, column))
                     {
-                        continue;
+                        if (this->IsNear(peak, other, window))
+                        {
+                            return true;
+                        }
                     }
-
-                    result.emplace_back(rho, degrees);
                 }
             }
+
+            return false;
         }
 
-        std::vector<tau::Line2d<Float>> GetLines(
-            const HoughSettings<Float> &settings)
+        bool HasNeighbor_(const Peak &peak, Index window)
         {
-            std::vector<tau::Line2d<Float>> result{};
+            if (this->SearchBuckets_(peak, peak.rho, peak.theta, window))
+            {
+                return true;
+            }
+
+            // The first and last theta are both 0 degrees.
+            Index period = this->thetaCount_ - 1;
+            Index mirroredRho = this->rhoCount_ - 1 - peak.rho;
 
-            if (settings.includeEdges)
+            if (peak.theta < window)
             {
-                this->GetLinesWithEdges(result, settings);
+                return this->SearchBuckets_(
+                    peak,
+                    mirroredRho,
+                    peak.theta + period,
+                    window);
             }
-            else
+
+            if (period - peak.theta < window)
             {
-                this->GetLinesWithoutEdges(result, settings);
+                return this->SearchBuckets_(
+                    peak,
+                    mirroredRho,
+                    peak.theta - period,
+                    window);
             }
 
-            // Shift the lines so they are relative to the image origin.
-            for (auto &line: result)
+            return false;
+        }
+
+        template<bool isRemoval>
+        void AddEdges_(
+            const CannyEdges &edges,
+            const ThetaBands &bands,
+            const chunk::Chunk &columns)
+        {
+            Index endColumn = columns.index + columns.count;
+
+            // The parts of the bands in this chunk of columns.
+            ThetaBands chunkBands;
+
+            for (auto &band: bands)
             {
-                line.point += this->center_;
+                Index first = std::max(band.index, columns.index);
+
+                Index end =
+                    std::min(band.index + band.count, endColumn);
+
+                if (end > first)
+                {
+                    chunkBands.push_back({first, end - first});
+                }
             }
 
-            return result;
+            bool isSaturated = false;
+
+            for (size_t i = 0; i < edges.size(); ++i)
+            {
+                auto point =
+                    tau::Point2d<Index>(edges.columns[i], edges.rows[i]);
+
+                auto vote = this->ToVote(edges.weights[i]);
+                auto phase = static_cast<Float>(edges.phases[i]);
+
+                for (auto &band: chunkBands)
+                {
+                    isSaturated |= this->AddPoint<isRemoval>(
+                        point,
+                        vote,
+                        phase,
+                        band.index,
+                        band.index + band.count);
+                }
+            }
+
+            // Each thread stores the flag once, instead of once per cell.
+            if (isSaturated)
+            {
+                this->isSaturated_ = true;
+            }
         }
 
-        void Accumulate(
-            const HoughSettings<Float> &settings,
-            const EdgePoints<Float> &edgePoints)
+        void CollectPeaks_(const chunk::Chunk &columns, Peaks &peaks) const
         {
-            this->Initialize(
-                settings.imageSize,
-                settings.rhoCount,
-                settings.thetaCount,
-                settings.angleRange);
+            const Count threshold = this->threshold_;
+            Index endColumn = columns.index + columns.count;
 
-            for (auto &edgePoint: edgePoints)
+            for (Index rho = 0; rho < this->rhoCount_; ++rho)
             {
-                this->AddPoint(
-                    edgePoint.GetPoint2d(),
-                    edgePoint.weight,
-                    edgePoint.phase);
+                const Count *row =
+                    this->space_->data() + rho * this->thetaCount_;
+
+                for (Index theta = columns.index; theta < endColumn; ++theta)
+                {
+                    if (row[theta] > threshold)
+                    {
+                        peaks.push_back({rho, theta, row[theta]});
+                    }
+                }
             }
         }
 
+        template<bool isRemoval>
+        bool AddPoint_(
+            const tau::Point2d<int32_t> &doubledPoint,
+            Count vote,
+            Float lowAngle,
+            Float highAngle,
+            Index firstColumn,
+            Index endColumn)
+        {
+            // Lookup indices, limited to the columns owned by this thread.
+            Index lowIndex =
+                std::max(this->ToThetaIndex(lowAngle), firstColumn);
+
+            Index highIndex =
+                std::min(this->ToThetaIndex(highAngle), endColumn);
+
+            assert(highIndex <= this->space_->cols());
+
+            const int32_t x = doubledPoint.x;
+            const int32_t y = doubledPoint.y;
+            const int32_t offset = this->fixedOffset_;
+            const int shift = this->fixedShift_;
+            const int32_t lastRho = static_cast<int32_t>(this->rhoCount_ - 1);
+
+            std::array<int32_t, kernelWidth> rhoIndices;
+            bool isSaturated = false;
+
+            for (
+                Index begin = lowIndex;
+                begin < highIndex;
+                begin += kernelWidth)
+            {
+                Index count = std::min(kernelWidth, highIndex - begin);
+                const int32_t *sines = &this->fixedSines_[size_t(begin)];
+                const int32_t *cosines = &this->fixedCosines_[size_t(begin)];
+
+                // rho = x * cosine(theta) + y * sine(theta)
+                // Independent lanes, so the compiler can vectorize this loop.
+                for (Index i = 0; i < count; ++i)
+                {
+                    int32_t rhoIndex =
+                        (y * sines[i] + x * cosines[i] + offset) >> shift;
+
+                    rhoIndices[size_t(i)] =
+                        std::min(lastRho, std::max(int32_t{0}, rhoIndex));
+                }
+
+                // Neighbouring thetas are adjacent within a row.
+                Count *cells = this->space_->data() + begin;
+
+                for (Index i = 0; i < count; ++i)
+                {
+                    auto &cell =
+                        cells[rhoIndices[size_t(i)] * this->thetaCount_ + i];
+
+                    if constexpr (isRemoval)
+                    {
+                        // Only integer spaces are updated, and they are
+                        // voted again after a cell saturates, so the
+                        // removed votes are always in the cell.
+                        cell = (cell > vote)
+                            ? static_cast<Count>(cell - vote)
+                            : Count(0);
+                    }
+                    else if constexpr (std::is_integral_v<Count>)
+                    {
+                        // Saturate instead of overflowing.
+                        if (cell > std::numeric_limits<Count>::max() - vote)
+                        {
+                            cell = std::numeric_limits<Count>::max();
+                            isSaturated = true;
+                        }
+                        else
+                        {
+                            cell = static_cast<Count>(cell + vote);
+                        }
+                    }
+                    else
+                    {
+                        cell += vote;
+                    }
+                }
+            }
+
+            return isSaturated;
+        }
+
     private:
+        int32_t width_;
+        int32_t height_;
         tau::Point2d<Float> center_;
         Float maximumRho_;
         Index rhoCount_;
@@ -515,17 +1162,62 @@ public:
         Index thetaCount_;
         Float angleRange_;
         RowVector thetas_;
-        Matrix sinesAndCosines_;
-        Matrix space_;
+        int fixedShift_;
+        FixedTable fixedSines_;
+        FixedTable fixedCosines_;
+        int32_t fixedOffset_;
+        bool weighted_;
+        Float weightScale_;
+        Count threshold_;
+        std::shared_ptr<Matrix> space_;
+        Index bucketSize_;
+        Index bucketRows_;
+        Index bucketColumns_;
+        std::vector<Peaks> buckets_;
+        std::atomic<bool> isSaturated_;
+        bool hasStream_;
+        CannyEdges streamEdges_;
+        ThetaBands streamBands_;
     };
 
-    Hough() = default;
+    Hough()
+        :
+        Hough(HoughSettings<Float>{})
+    {
+
+    }
 
     Hough(const HoughSettings<Float> &settings)
         :
-        settings_(settings)
+        settings_(settings),
+        accumulatorSettings_(GetAccumulatorSettings(settings)),
+        shared_(std::make_shared<SharedAccumulator>())
+    {
+        this->shared_->accumulator =
+            std::make_unique<Accumulator>(this->accumulatorSettings_);
+    }
+
+    // With a coarseFactor above 1, the accumulator and the suppression
+    // window are reduced by coarseFactor in rho and theta.
+    static HoughSettings<Float> GetAccumulatorSettings(
+        const HoughSettings<Float> &settings)
     {
+        auto result = settings;
+        auto factor = std::max(size_t{1}, settings.coarseFactor);
+
+        if (factor == 1)
+        {
+            return result;
+        }
+
+        result.rhoCount = std::max(size_t{2}, settings.rhoCount / factor);
+        result.thetaCount = std::max(size_t{2}, settings.thetaCount / factor);
+
+        result.window = std::max(
+            Index{1},
+            settings.window / static_cast<Index>(factor));
 
+        return result;
     }
 
     bool Filter(const CannyResult<Float> &canny, Result &result) const
@@ -535,114 +1227,302 @@ public:
             return false;
         }
 
-        EdgePoints<Float> edgePoints;
+        // Use the edge list from Canny when it was created, otherwise
+        // collect it from the edge map.
+        std::optional<CannyEdges> scanned;
 
-        if (this->settings_.weighted)
+        if (!canny.edgeList)
         {
-            edgePoints =
-                MakeEdgePoints<WeightedEdgeMaker>(canny.matrix, canny.phasor);
+            scanned = canny.ScanEdgeList();
         }
-        else
+
+        const CannyEdges &edges = (scanned) ? *scanned : *canny.edgeList;
+
+        auto accumulator = this->TakeAccumulator_();
+
+        // Optionally vote only the edges near the dominant orientations,
+        // and only into the theta bands around them.
+        std::optional<CannyEdges> selected;
+        auto bands = accumulator->GetAllThetas();
+
+        if (this->settings_.orientationModes > 0)
         {
-            edgePoints =
-                MakeEdgePoints<EdgeMaker>(canny.matrix, canny.phasor);
+            auto modes = FindOrientationModes(
+                edges,
+                this->settings_.orientationModes,
+                this->settings_.modeWidth,
+                this->settings_.weighted);
+
+            selected =
+                SelectOrientationEdges(edges, modes, this->settings_.modeWidth);
+
+            bands =
+                accumulator->GetThetaBands(modes, this->settings_.modeWidth);
         }
 
-        Index maximumColumn = 0;
-        Index maximumRow = 0;
+        const CannyEdges &votingEdges = (selected) ? *selected : edges;
+
+        // In streaming mode, only the edges that changed since the previous
+        // frame are voted, unless too many have changed.
+        // Floating-point counts would drift as votes are removed, so only
+        // integer counts stream.
+        bool isIncremental = false;
+        CannyEdges added;
+        CannyEdges removed;
 
-        for (auto &edgePoint: edgePoints)
+        if (this->settings_.streaming && std::is_integral_v<Count>)
         {
-            maximumColumn = std::max(maximumColumn, edgePoint.column);
-            maximumRow = std::max(maximumRow, edgePoint.row);
+            isIncremental = accumulator->Difference(
+                votingEdges,
+                bands,
+                this->settings_.streamingLimit,
+                added,
+                removed);
         }
+        else
+        {
+            accumulator->ResetStream();
+        }
+
+        accumulator->Prepare(isIncremental);
+        auto thetaCount = accumulator->GetThetaCount();
+
+        auto threadCount = static_cast<size_t>(
+            std::clamp(
+                static_cast<Index>(this->settings_.threads),
+                Index{1},
+                thetaCount));
 
-        auto chunks = chunk::MakeChunks(
-            this->settings_.threads,
-            static_cast<Index>(edgePoints.size()));
+        auto chunks = chunk::MakeChunks(threadCount, thetaCount);
 
         std::vector<jive::Sentry> threadSentries;
+        threadSentries.reserve(chunks.size());
         auto threadPool = jive::GetThreadPool();
 
-        std::vector<Accumulator> accumulators(chunks.size());
+        using Peaks = typename Accumulator::Peaks;
+        std::vector<Peaks> chunkPeaks(chunks.size());
 
         for (auto index: jive::Range<size_t>(0, chunks.size()))
         {
-            auto &chunk = chunks[index];
-            auto &accumulator = accumulators[index];
-
-            auto begin = std::begin(edgePoints) + chunk.index;
-            auto end = begin + chunk.count;
-
             threadSentries.emplace_back(
                 threadPool->AddJob(
-                    [&]()
+                    [&, index]()
                     {
-                        accumulator.Accumulate(
-                            this->settings_,
-                            EdgePoints<Float>(begin, end));
+                        if (isIncremental)
+                        {
+                            accumulator->Update(
+                                removed,
+                                added,
+                                bands,
+                                chunks[index],
+                                chunkPeaks[index]);
+                        }
+                        else
+                        {
+                            accumulator->Vote(
+                                votingEdges,
+                                bands,
+                                chunks[index],
+                                chunkPeaks[index]);
+                        }
                     }));
         }
 
-        threadSentries.front().Wait();
-        auto &accumulator = accumulators.front();
-        Matrix combined = accumulator.GetSpace();
+        chunk::AwaitThreads(threadSentries);
 
-        for (size_t i = 1; i < threadSentries.size(); ++i)
+        if (accumulator->IsSaturated())
         {
-            threadSentries[i].Wait();
-            combined += accumulators[i].GetSpace();
+            // This frame is exact, but the next must be voted again.
+            accumulator->ResetStream();
         }
 
-        if (this->settings_.suppress)
+        Peaks peaks = std::move(chunkPeaks.front());
+
+        for (size_t i = 1; i < chunkPeaks.size(); ++i)
         {
-            auto windowSize = this->settings_.window;
+            peaks.insert(
+                std::end(peaks),
+                std::begin(chunkPeaks[i]),
+                std::end(chunkPeaks[i]));
+        }
 
-            Suppression(
-                this->settings_.threads,
-                windowSize,
-                combined,
-                result.space);
+        result.lines =
+            accumulator->GetLines(peaks, this->accumulatorSettings_);
 
-            // Run suppression again on the seam between 180 and 0.
-            auto seam = Matrix(result.space.rows(), 2 * windowSize);
+        result.space = accumulator->GetSpace();
+        auto tolerance = accumulator->GetRhoStep();
+        this->ReturnAccumulator_(std::move(accumulator));
 
-            seam.leftCols(windowSize) =
-                result.space.rightCols(windowSize);
+        if (this->settings_.coarseFactor > 1)
+        {
+            // Refine each coarse line to the edges that support it.
+            // The first pass accepts edges within one coarse rho step, and
+            // the second pass within half of that.
 
-            seam.rightCols(windowSize) =
-                result.space.leftCols(windowSize).colwise().reverse();
+            for (auto &line: result.lines)
+            {
+                for (int pass = 0; pass < 2; ++pass)
+                {
+                    auto fitted = this->FitLine_(
+                        line,
+                        edges,
+                        std::max(Float(1), tolerance / Float(1 << pass)));
 
-            using Space = std::remove_cvref_t<decltype(result.space)>;
+                    if (!fitted)
+                    {
+                        break;
+                    }
 
-            Space suppressedSeam;
+                    line = *fitted;
+                }
+            }
+        }
 
-            Suppression(
-                this->settings_.threads,
-                windowSize,
-                seam,
-                suppressedSeam);
+        return true;
+    }
 
-            result.space.rightCols(windowSize) =
-                suppressedSeam.leftCols(windowSize);
+private:
+    // Copies of this filter share the accumulator, so that streaming
+    // continues from the previous frame. The mutex is only held to take
+    // and return the accumulator, and a call that finds it in use by
+    // another copy votes into a new accumulator.
+    struct SharedAccumulator
+    {
+        std::mutex mutex;
+        std::unique_ptr<Accumulator> accumulator;
+    };
 
-            result.space.leftCols(windowSize) =
-                suppressedSeam.rightCols(windowSize).colwise().reverse();
+    std::unique_ptr<Accumulator> TakeAccumulator_() const
+    {
+        {
+            std::lock_guard lock(this->shared_->mutex);
 
-            accumulator.SetSpace(result.space);
-            result.lines = accumulator.GetLines(this->settings_);
+            if (this->shared_->accumulator)
+            {
+                return std::move(this->shared_->accumulator);
+            }
         }
-        else
+
+        return std::make_unique<Accumulator>(this->accumulatorSettings_);
+    }
+
+    void ReturnAccumulator_(std::unique_ptr<Accumulator> accumulator) const
+    {
+        std::lock_guard lock(this->shared_->mutex);
+        this->shared_->accumulator = std::move(accumulator);
+    }
+
+    // Fits a line by total least squares to the edges that lie within
+    // tolerance pixels of line and have a phase within angleRange of its
+    // normal.
+    std::optional<tau::Line2d<Float>> FitLine_(
+        const tau::Line2d<Float> &line,
+        const CannyEdges &edges,
+        Float tolerance) const
+    {
+        // The normal of a line at theta is (cos(theta), sin(theta)).
+        Float normalX = line.vector.y;
+        Float normalY = -line.vector.x;
+
+        auto normalDegrees =
+            tau::ToDegrees(std::atan2(normalY, normalX));
+
+        Float distance = normalX * line.point.x + normalY * line.point.y;
+        Float angleRange = this->settings_.angleRange;
+
+        Float weightSum = 0;
+        Float sumX = 0;
+        Float sumY = 0;
+        Float sumXX = 0;
+        Float sumXY = 0;
+        Float sumYY = 0;
+        size_t count = 0;
+
+        for (size_t i = 0; i < edges.size(); ++i)
         {
-            result.space = combined;
+            auto x = static_cast<Float>(edges.columns[i]);
+            auto y = static_cast<Float>(edges.rows[i]);
+
+            if (std::abs(normalX * x + normalY * y - distance) > tolerance)
+            {
+                continue;
+            }
+
+            // The phase of an edge on the line is parallel to the normal,
+            // in either direction.
+            auto phaseDifference = std::abs(
+                std::fmod(
+                    static_cast<Float>(edges.phases[i]) - normalDegrees + 630,
+                    Float(180)) - 90);
+
+            if (phaseDifference > angleRange)
+            {
+                continue;
+            }
+
+            Float weight = (this->settings_.weighted)
+                ? static_cast<Float>(edges.weights[i])
+                : Float(1);
+
+            weightSum += weight;
+            sumX += weight * x;
+            sumY += weight * y;
+            sumXX += weight * x * x;
+            sumXY += weight * x * y;
+            sumYY += weight * y * y;
+            ++count;
         }
 
-        return true;
+        if (count < 2 || weightSum <= 0)
+        {
+            return {};
+        }
+
+        Float meanX = sumX / weightSum;
+        Float meanY = sumY / weightSum;
+        Float varianceX = sumXX / weightSum - meanX * meanX;
+        Float varianceY = sumYY / weightSum - meanY * meanY;
+        Float covariance = sumXY / weightSum - meanX * meanY;
+
+        // The direction of greatest variance.
+        Float angle =
+            std::atan2(2 * covariance, varianceX - varianceY) / 2;
+
+        auto direction =
+            tau::Vector2d<Float>(std::cos(angle), std::sin(angle));
+
+        // Keep the orientation of the line from the accumulator.
+        if (direction.x * line.vector.x + direction.y * line.vector.y < 0)
+        {
+            direction = direction * Float(-1);
+        }
+
+        return tau::Line2d<Float>(
+            tau::Point2d<Float>(meanX, meanY),
+            direction);
     }
 
 private:
     HoughSettings<Float> settings_;
+    HoughSettings<Float> accumulatorSettings_;
+    std::shared_ptr<SharedAccumulator> shared_;
 };
 
 
+extern template struct HoughResult<double>;
+extern template class Hough<double>;
+
+extern template struct HoughResult<double, uint16_t>;
+extern template class Hough<double, uint16_t>;
+
+extern template struct HoughResult<double, uint32_t>;
+extern template class Hough<double, uint32_t>;
+
+extern template struct HoughResult<float>;
+extern template class Hough<float>;
+
+extern template struct HoughResult<float, uint32_t>;
+extern template class Hough<float, uint32_t>;
+
+
 } // end namespace iris
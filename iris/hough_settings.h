@@ -22,13 +22,20 @@ struct HoughFields
         fields::Field(&T::imageSize, "imageSize"),
         fields::Field(&T::rhoCount, "rhoCount"),
         fields::Field(&T::thetaCount, "thetaCount"),
+        fields::Field(&T::coarseFactor, "coarseFactor"),
         fields::Field(&T::angleRange, "angleRange"),
+        fields::Field(&T::orientationModes, "orientationModes"),
+        fields::Field(&T::modeWidth, "modeWidth"),
         fields::Field(&T::weighted, "weighted"),
+        fields::Field(&T::weightScale, "weightScale"),
         fields::Field(&T::suppress, "suppress"),
         fields::Field(&T::window, "window"),
         fields::Field(&T::threshold, "threshold"),
+        fields::Field(&T::maximumLines, "maximumLines"),
         fields::Field(&T::includeEdges, "includeEdges"),
         fields::Field(&T::edgeTolerance, "edgeTolerance"),
+        fields::Field(&T::streaming, "streaming"),
+        fields::Field(&T::streamingLimit, "streamingLimit"),
         fields::Field(&T::threads, "threads"));
 
     static constexpr auto fieldsTypeName = "Hough";
@@ -56,13 +63,20 @@ struct HoughTemplate
         T<draw::SizeGroup> imageSize;
         T<size_t> rhoCount;
         T<size_t> thetaCount;
+        T<size_t> coarseFactor;
         T<pex::MakeRange<Float, AngleRangeLow, AngleRangeHigh>> angleRange;
+        T<size_t> orientationModes;
+        T<Float> modeWidth;
         T<bool> weighted;
+        T<Float> weightScale;
         T<bool> suppress;
         T<WindowRange> window;
         T<ThresholdRange<Float>> threshold;
+        T<size_t> maximumLines;
         T<bool> includeEdges;
         T<Float> edgeTolerance;
+        T<bool> streaming;
+        T<Float> streamingLimit;
         T<size_t> threads;
 
         static constexpr auto fields = HoughFields<Template>::fields;
@@ -82,17 +96,43 @@ struct HoughCustom
         // 10ths of a degree
         static constexpr size_t defaultThetaCount = 1024;
 
+        // Votes into an accumulator this many times smaller in rho and
+        // theta, then refines each line by fitting it to its edges.
+        // 1 votes at full resolution without refinement.
+        static constexpr size_t defaultCoarseFactor = 1;
+
         // How far to search beyond the detected edge angle.
         static constexpr Float defaultAngleRange = 15;
 
+        // Counts per unit weight when an integer accumulator stores
+        // weighted votes in fixed point.
+        static constexpr Float defaultWeightScale = 256;
+
+        // The number of dominant edge orientations to vote for.
+        // 0 votes every edge over every theta.
+        static constexpr size_t defaultOrientationModes = 0;
+
+        // Edges and thetas within this many degrees of a dominant
+        // orientation are voted.
+        static constexpr Float defaultModeWidth = 10;
+
         // The size of the non-maximum suppression window.
         static constexpr Eigen::Index defaultWindow = 24;
 
         // Minimum value to be considered a line.
         static constexpr size_t defaultThreshold = 110;
 
+        // The strongest lines are kept when more are found.
+        // 0 keeps every line.
+        static constexpr size_t defaultMaximumLines = 0;
+
         static constexpr size_t defaultEdgeTolerance = 4;
 
+        // In streaming mode, the accumulator is voted again from scratch
+        // when more than this fraction of the edges changed.
+        // Only integer accumulators stream.
+        static constexpr Float defaultStreamingLimit = 0.25;
+
         static constexpr size_t defaultThreads = 4;
 
         Plain()
@@ -102,13 +142,20 @@ struct HoughCustom
                 defaultImageSize,
                 defaultRhoCount,
                 defaultThetaCount,
+                defaultCoarseFactor,
                 defaultAngleRange,
+                defaultOrientationModes,
+                defaultModeWidth,
                 true,
+                defaultWeightScale,
                 true,
                 defaultWindow,
                 defaultThreshold,
+                defaultMaximumLines,
                 false,
                 defaultEdgeTolerance,
+                false,
+                defaultStreamingLimit,
                 defaultThreads}
         {
 
@@ -1,9 +1,13 @@
 #pragma once
 
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <utility>
 #include <tau/color_map.h>
-#include <tau/percentile.h>
 #include <tau/mono_image.h>
 
+#include "iris/histogram.h"
 #include "iris/level_settings.h"
 #include "iris/node.h"
 #include "iris/mask.h"
@@ -69,6 +73,50 @@ protected:
 };
 
 
+// Estimates the low and high levels at the margin and (1 - margin)
+// percentiles of the non-zero input values.
+// The input is bounded by maximum, so a histogram replaces sorting.
+template<typename Derived>
+std::optional<std::pair<typename Derived::Scalar, typename Derived::Scalar>>
+DetectLevels(
+    const Eigen::MatrixBase<Derived> &input,
+    typename Derived::Scalar maximum,
+    double margin,
+    size_t threads,
+    Eigen::Index stride)
+{
+    using Value = typename Derived::Scalar;
+    static_assert(std::is_integral_v<Value>);
+
+    auto toBin = [&](Eigen::Index row, Eigen::Index column) -> size_t
+    {
+        return static_cast<size_t>(
+            std::max(Value{0}, std::min(maximum, input(row, column))));
+    };
+
+    auto histogram = MakeHistogram(
+        static_cast<size_t>(maximum) + 1,
+        input.rows(),
+        input.cols(),
+        threads,
+        stride,
+        toBin);
+
+    // The input to this node may be a mask that sets masked values to zero.
+    // Estimate the low and high percentile without considering the zeros.
+    static constexpr size_t firstBin = 1;
+
+    if (histogram.GetTotal(firstBin) < 2)
+    {
+        return {};
+    }
+
+    return std::make_pair(
+        static_cast<Value>(*histogram.GetPercentile(margin, firstBin)),
+        static_cast<Value>(*histogram.GetPercentile(1.0 - margin, firstBin)));
+}
+
+
 template<typename SourceNode, typename Value, typename Float>
 class LevelAdjustNode
     :
@@ -95,6 +143,13 @@ public:
 
     }
 
+    // Levels have no thread setting, and detection only runs on request,
+    // so it uses every core.
+    static size_t GetDetectThreads()
+    {
+        return std::max(1u, std::thread::hardware_concurrency());
+    }
+
     void AutoDetectSettings()
     {
         auto input = this->input_.GetResult();
@@ -105,28 +160,25 @@ public:
             return;
         }
 
-        auto filtered = tau::RemoveZeros(*input);
+        auto levels = DetectLevels(
+            *input,
+            this->settings_.maximum,
+            this->settings_.detectMargin,
+            GetDetectThreads(),
+            static_cast<Eigen::Index>(this->settings_.detectStride));
 
-        if (filtered.size() < 2)
+        auto defer = pex::MakeDefer(this->control_);
+
+        if (!levels)
         {
-            auto defer = pex::MakeDefer(this->control_);
             defer.range.low.Set(0);
             defer.range.high.Set(255);
 
             return;
         }
 
-        // The input to this node may be a mask that sets masked values to zero.
-        // Estimate the low and high percentile without considering the zeros.
-        auto values = tau::Percentile(
-            filtered,
-            Eigen::Vector2d(
-                this->settings_.detectMargin,
-                1.0 - this->settings_.detectMargin));
-
-        auto defer = pex::MakeDefer(this->control_);
-        defer.range.low.Set(values(0));
-        defer.range.high.Set(values(1));
+        defer.range.low.Set(levels->first);
+        defer.range.high.Set(levels->second);
     }
 
     using DetectEndpoint =
@@ -23,7 +23,8 @@ struct LevelFields
         fields::Field(&T::range, "range"),
         fields::Field(&T::maximum, "maximum"),
         fields::Field(&T::autoDetectSettings, "autoDetectSettings"),
-        fields::Field(&T::detectMargin, "detectMargin"));
+        fields::Field(&T::detectMargin, "detectMargin"),
+        fields::Field(&T::detectStride, "detectStride"));
 };
 
 
@@ -70,6 +71,8 @@ struct LevelTemplate
 
         T<DetectRange> detectMargin;
 
+        T<DetectStrideRange> detectStride;
+
         static constexpr auto fields = LevelFields<Template>::fields;
         static constexpr auto fieldsTypeName = "Level";
     };
@@ -87,7 +90,8 @@ struct LevelSettings:
             typename LevelRanges<Value>::Settings{},
             defaultMaximum,
             {},
-            0.05}
+            0.05,
+            1}
     {
 
     }
@@ -6,7 +6,8 @@ namespace iris
 {
 
 
-LinesChainResults::LinesChainResults(int64_t shapesId)
+template<typename Float>
+LinesChainResults<Float>::LinesChainResults(int64_t shapesId)
     :
     cannyChain{},
     hough{},
@@ -16,7 +17,8 @@ LinesChainResults::LinesChainResults(int64_t shapesId)
 }
 
 
-std::shared_ptr<draw::Pixels> LinesChainResults::Display(
+template<typename Float>
+std::shared_ptr<draw::Pixels> LinesChainResults<Float>::Display(
     const tau::Margins &margins,
     const draw::AsyncShapesControl &shapesControl,
     const draw::LinesShapeSettings &linesShapeSettings,
@@ -38,8 +40,10 @@ std::shared_ptr<draw::Pixels> LinesChainResults::Display(
 
         if (houghControl)
         {
-            auto scale = static_cast<double>(color.GetSettings().maximum);
-            ProcessMatrix space = houghResult.GetScaledSpace<int32_t>(scale);
+            auto scale = static_cast<Float>(color.GetSettings().maximum);
+
+            ProcessMatrix space =
+                houghResult.template GetScaledSpace<int32_t>(scale);
 
             auto houghPixels = color.Filter(space);
 
@@ -64,7 +68,11 @@ std::shared_ptr<draw::Pixels> LinesChainResults::Display(
 }
 
 
-template class LinesChain<DefaultLevelAdjustNode>;
+template struct LinesChainResults<float>;
+template struct LinesChainResults<double>;
+
+template class LinesChain<float, DefaultLevelAdjustNode>;
+template class LinesChain<double, DefaultLevelAdjustNode>;
 
 
 } // end namespace iris
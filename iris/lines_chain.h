@@ -14,16 +14,18 @@ namespace iris
 {
 
 
+template<typename Float>
 struct LinesChainFilters
 {
-    using HoughFilter = Hough<double>;
+    using HoughFilter = Hough<Float, uint32_t>;
 };
 
 
+template<typename Float>
 struct LinesChainResults
 {
-    using Filters = LinesChainFilters;
-    std::shared_ptr<const CannyChainResults> cannyChain;
+    using Filters = LinesChainFilters<Float>;
+    std::shared_ptr<const CannyChainResults<Float>> cannyChain;
     std::shared_ptr<const typename Filters::HoughFilter::Result> hough;
 
     using HoughPixelsControl =
@@ -44,25 +46,25 @@ private:
 
 
 
-template<typename SourceNode>
+template<typename Float, typename SourceNode>
 struct LinesChainNodes
 {
-    using Filters = LinesChainFilters;
+    using Filters = LinesChainFilters<Float>;
     using HoughFilter = typename Filters::HoughFilter;
 
     using Result = typename HoughFilter::Result;
 
-    using CannyChainNode = CannyChain<SourceNode>;
+    using CannyChainNode = CannyChain<Float, SourceNode>;
 
     using HoughNode =
-        iris::Node<CannyChainNode, HoughFilter, HoughControl<double>>;
+        iris::Node<CannyChainNode, HoughFilter, HoughControl<Float>>;
 
     CannyChainNode cannyChain;
     HoughNode hough;
 
     LinesChainNodes(
         SourceNode &source,
-        LinesChainControl controls,
+        LinesChainControl<Float> controls,
         CancelControl cancel)
         :
         cannyChain(source, controls.cannyChain, cancel),
@@ -73,34 +75,34 @@ struct LinesChainNodes
 };
 
 
-template<typename SourceNode>
+template<typename Float, typename SourceNode>
 class LinesChain
     :
     public NodeBase
         <
             SourceNode,
-            LinesChainControl,
-            typename LinesChainNodes<SourceNode>::Result,
-            LinesChain<SourceNode>
+            LinesChainControl<Float>,
+            typename LinesChainNodes<Float, SourceNode>::Result,
+            LinesChain<Float, SourceNode>
         >
 {
 public:
-    using Result = typename LinesChainNodes<SourceNode>::Result;
+    using Result = typename LinesChainNodes<Float, SourceNode>::Result;
     using ResultPtr = std::shared_ptr<const Result>;
-    using ChainResults = LinesChainResults;
+    using ChainResults = LinesChainResults<Float>;
     using ChainResultsPtr = std::shared_ptr<const ChainResults>;
 
     using Base = NodeBase
         <
             SourceNode,
-            LinesChainControl,
+            LinesChainControl<Float>,
             Result,
-            LinesChain<SourceNode>
+            LinesChain<Float, SourceNode>
         >;
 
     LinesChain(
         SourceNode &sourceNode,
-        LinesChainControl controls,
+        LinesChainControl<Float> controls,
         CancelControl cancel)
         :
         Base("LinesChain", sourceNode, controls, cancel),
@@ -160,11 +162,17 @@ public:
 
 private:
     draw::ShapesId shapesId_;
-    LinesChainNodes<SourceNode> nodes_;
+    LinesChainNodes<Float, SourceNode> nodes_;
 };
 
 
-extern template class LinesChain<DefaultLevelAdjustNode>;
-using DefaultLinesChain = LinesChain<DefaultLevelAdjustNode>;
+extern template struct LinesChainResults<float>;
+extern template struct LinesChainResults<double>;
+
+extern template class LinesChain<float, DefaultLevelAdjustNode>;
+extern template class LinesChain<double, DefaultLevelAdjustNode>;
+
+template<typename Float>
+using DefaultLinesChain = LinesChain<Float, DefaultLevelAdjustNode>;
 
 } // end namespace iris
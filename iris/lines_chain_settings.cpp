@@ -4,6 +4,14 @@
 template struct pex::Group
     <
         iris::LinesChainFields,
-        iris::LinesChainTemplate,
-        iris::LinesChainCustom
+        iris::LinesChainTemplate<float>::template Template,
+        iris::LinesChainCustom<float>
+    >;
+
+
+template struct pex::Group
+    <
+        iris::LinesChainFields,
+        iris::LinesChainTemplate<double>::template Template,
+        iris::LinesChainCustom<double>
     >;
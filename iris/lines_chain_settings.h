@@ -56,19 +56,24 @@ struct LinesChainFields
 };
 
 
-template<template<typename> typename T>
+template<typename Float>
 struct LinesChainTemplate
 {
-    T<bool> enable;
-    T<CannyChainGroup> cannyChain;
-    T<HoughGroup<double>> hough;
-    T<draw::LinesShapeGroup> shape;
+    template<template<typename> typename T>
+    struct Template
+    {
+        T<bool> enable;
+        T<CannyChainGroup<Float>> cannyChain;
+        T<HoughGroup<Float>> hough;
+        T<draw::LinesShapeGroup> shape;
 
-    static constexpr auto fields = LinesChainFields<LinesChainTemplate>::fields;
-    static constexpr auto fieldsTypeName = "LineChain";
+        static constexpr auto fields = LinesChainFields<Template>::fields;
+        static constexpr auto fieldsTypeName = "LineChain";
+    };
 };
 
 
+template<typename Float>
 struct LinesChainCustom
 {
     template<typename Base>
@@ -78,8 +83,8 @@ struct LinesChainCustom
             :
             Base{
                 true,
-                CannyChainSettings{},
-                HoughSettings<double>{},
+                CannyChainSettings<Float>{},
+                HoughSettings<Float>{},
                 draw::LinesShapeSettings{}}
         {
 
@@ -120,20 +125,29 @@ struct LinesChainCustom
 };
 
 
+template<typename Float>
 using LinesChainGroup = pex::Group
     <
         LinesChainFields,
-        LinesChainTemplate,
-        LinesChainCustom
+        LinesChainTemplate<Float>::template Template,
+        LinesChainCustom<Float>
     >;
 
 
-using LinesChainSettings = typename LinesChainGroup::Plain;
-using LinesChainModel = typename LinesChainGroup::Model;
-using LinesChainControl = typename LinesChainGroup::DefaultControl;
+template<typename Float>
+using LinesChainSettings = typename LinesChainGroup<Float>::Plain;
+
+template<typename Float>
+using LinesChainModel = typename LinesChainGroup<Float>::Model;
+
+template<typename Float>
+using LinesChainControl = typename LinesChainGroup<Float>::DefaultControl;
+
+DECLARE_EQUALITY_OPERATORS(LinesChainSettings<float>)
+DECLARE_OUTPUT_STREAM_OPERATOR(LinesChainSettings<float>)
 
-DECLARE_EQUALITY_OPERATORS(LinesChainSettings)
-DECLARE_OUTPUT_STREAM_OPERATOR(LinesChainSettings)
+DECLARE_EQUALITY_OPERATORS(LinesChainSettings<double>)
+DECLARE_OUTPUT_STREAM_OPERATOR(LinesChainSettings<double>)
 
 
 } // end namespace iris
@@ -142,6 +156,14 @@ DECLARE_OUTPUT_STREAM_OPERATOR(LinesChainSettings)
 extern template struct pex::Group
     <
         iris::LinesChainFields,
-        iris::LinesChainTemplate,
-        iris::LinesChainCustom
+        iris::LinesChainTemplate<float>::template Template,
+        iris::LinesChainCustom<float>
+    >;
+
+
+extern template struct pex::Group
+    <
+        iris::LinesChainFields,
+        iris::LinesChainTemplate<double>::template Template,
+        iris::LinesChainCustom<double>
     >;
@@ -21,9 +21,9 @@ MaskMatrix CreateMask(const MaskSettings &maskSettings)
 
     if (maskSettings.polygons.empty())
     {
-        return MaskMatrix::Zero(
+        return MaskMatrix::Ones(
             maskSettings.imageSize.height,
-            maskSettings.imageSize.width).array() + 1.0;
+            maskSettings.imageSize.width);
     }
 
     const auto &value = maskSettings.polygons[0];
@@ -40,9 +40,9 @@ MaskMatrix CreateMask(const MaskSettings &maskSettings)
 
     if (polygon.points.size() < 3)
     {
-        return MaskMatrix::Zero(
+        return MaskMatrix::Ones(
             maskSettings.imageSize.height,
-            maskSettings.imageSize.width).array() + 1.0;
+            maskSettings.imageSize.width);
     }
 
     wxBitmap bitmap(wxpex::ToWxSize(maskSettings.imageSize));
@@ -88,7 +88,7 @@ MaskMatrix CreateMask(const MaskSettings &maskSettings)
 
     if (!maskSettings.feather.enable)
     {
-        return red;
+        return red.template cast<float>();
     }
 
     auto gaussian = Gaussian<double, 0>(maskSettings.feather);
@@ -98,7 +98,7 @@ MaskMatrix CreateMask(const MaskSettings &maskSettings)
 
     assert(filterResult);
 
-    return feather;
+    return feather.template cast<float>();
 }
 
 
@@ -9,7 +9,8 @@ namespace iris
 {
 
 
-using MaskMatrix = Eigen::MatrixX<double>;
+// Single precision is plenty for weights in [0, 1] applied to pixel values.
+using MaskMatrix = Eigen::MatrixX<float>;
 
 MaskMatrix CreateMask(const MaskSettings &maskSettings);
 
@@ -65,7 +66,7 @@ public:
         assert(input.cols() == this->mask_->cols());
 
         MaskMatrix resultAsFloat =
-            input.template cast<double>().array() * this->mask_->array();
+            input.template cast<float>().array() * this->mask_->array();
 
         result = resultAsFloat.template cast<Value>();
 
@@ -0,0 +1,12 @@
+#include "iris/saddle.h"
+
+
+namespace iris
+{
+
+
+template class Saddle<float>;
+template class Saddle<double>;
+
+
+} // end namespace iris
@@ -0,0 +1,491 @@
+#pragma once
+
+
+#include <algorithm>
+#include <cmath>
+#include <tau/eigen.h>
+#include <tau/mono_image.h>
+
+#include "iris/chunks.h"
+#include "iris/gaussian.h"
+#include "iris/saddle_settings.h"
+#include "iris/suppression.h"
+#include "iris/threadsafe_filter.h"
+#include "iris/vertex.h"
+
+
+namespace iris
+{
+
+
+/*
+ * Finds saddle points, like the vertices of a chessboard, where the Hessian
+ * of the smoothed image has a negative determinant.
+ *
+ * The second partial derivatives come from separable derivative-of-Gaussian
+ * kernels: three passes along the rows and three along the columns, in
+ * cache-sized bands. The strongest saddles are kept by suppression, and
+ * each is moved to the stationary point of the intensity by one Newton
+ * step.
+ *
+ * This is an alternative to Harris followed by VertexFinder, with the same
+ * result type. Each vertex has one value point, at the pixel of the saddle.
+ */
+template<typename Float>
+class Saddle
+{
+public:
+    using Result = VertexSet;
+    using Image = tau::MonoImage<Float>;
+    using Kernel = Eigen::VectorX<Float>;
+
+    Saddle() = default;
+
+    Saddle(const SaddleSettings &settings)
+        :
+        settings_(settings),
+        smoothing_(),
+        derivative_(),
+        secondDerivative_()
+    {
+        auto sigma = static_cast<Float>(settings.sigma);
+
+        auto radius = std::round(
+            GaussianKernel<Float, Float, 0>::GetRadius(
+                sigma,
+                kernelThreshold));
+
+        auto size = static_cast<Eigen::Index>(1 + 2 * radius);
+
+        this->smoothing_ = Sample<Float, 0>(sigma, size);
+
+        // Correlating with the negated kernel gives the derivative.
+        this->derivative_ = -Sample<Float, 1>(sigma, size);
+        this->secondDerivative_ = Sample<Float, 2>(sigma, size);
+    }
+
+    template<typename Derived>
+    bool Filter(const Eigen::MatrixBase<Derived> &input, Result &result) const
+    {
+        using Eigen::Index;
+
+        if (!this->settings_.enable)
+        {
+            return false;
+        }
+
+        result.Clear();
+
+        if (input.rows() == 0 || input.cols() == 0)
+        {
+            return true;
+        }
+
+        Image response = this->GetResponse_(input);
+
+        // Zero beyond the image edges makes false saddles near them.
+        Index margin = this->smoothing_.size() / 2;
+        Index innerRows = input.rows() - 2 * margin;
+        Index innerColumns = input.cols() - 2 * margin;
+
+        if (innerRows <= 0 || innerColumns <= 0)
+        {
+            return true;
+        }
+
+        auto inner =
+            response.block(margin, margin, innerRows, innerColumns);
+
+        Float maximum = inner.maxCoeff();
+
+        if (maximum <= 0)
+        {
+            return true;
+        }
+
+        auto thresholdValue =
+            static_cast<Float>(this->settings_.threshold) * maximum;
+
+        auto thresholded =
+            (inner.array() < thresholdValue)
+                .select(Float(0), inner.array())
+                .matrix();
+
+        auto maxima = FindLocalMaxima(
+            this->settings_.threads,
+            this->settings_.window,
+            thresholded);
+
+        result.Reserve(maxima.size(), maxima.size());
+
+        for (auto &saddle: maxima)
+        {
+            Index row = saddle.row + margin;
+            Index column = saddle.column + margin;
+
+            draw::ValuePoint<double> valuePoint(
+                static_cast<double>(column),
+                static_cast<double>(row),
+                static_cast<double>(saddle.value / maximum));
+
+            result.Add(
+                this->Refine_(input, row, column),
+                &valuePoint,
+                &valuePoint + 1);
+        }
+
+        return true;
+    }
+
+private:
+    static constexpr Float kernelThreshold = static_cast<Float>(0.001);
+    static constexpr Eigen::Index bandBytes = 256 * 1024;
+
+    // Buffers reused from one band to the next.
+    struct Workspace
+    {
+        Workspace(Eigen::Index haloRows, Eigen::Index columns)
+            :
+            image(haloRows, columns),
+            smoothed(haloRows, columns),
+            derivative(haloRows, columns),
+            secondDerivative(haloRows, columns),
+            xx(),
+            yy(),
+            xy()
+        {
+
+        }
+
+        Image image;
+
+        // The rows read by a band, filtered along the rows by each kernel.
+        Image smoothed;
+        Image derivative;
+        Image secondDerivative;
+
+        Image xx;
+        Image yy;
+        Image xy;
+    };
+
+    // The number of rows in a band, sized so that a band's working set
+    // stays in L2, and so that every thread gets a band.
+    Eigen::Index GetBandRows_(Eigen::Index rows, Eigen::Index columns) const
+    {
+        using Eigen::Index;
+
+        // A band holds about seven rows of intermediate values for each of
+        // its rows.
+        auto rowBytes = static_cast<Index>(sizeof(Float)) * columns * 7;
+        Index bandRows = std::max(Index{1}, bandBytes / rowBytes);
+
+        auto threads = static_cast<Index>(
+            std::max(this->settings_.threads, size_t{1}));
+
+        return std::max(
+            Index{1},
+            std::min(bandRows, (rows + threads - 1) / threads));
+    }
+
+    /*
+     * Computes the negated determinant of the Hessian where it is negative,
+     * and zero elsewhere, one band of rows at a time. Each band filters the
+     * rows it reads along the rows, then filters its own rows along the
+     * columns, and writes only its rows of the response.
+     *
+     * Consecutive bands read overlapping rows, so the rows filtered for one
+     * band are kept for the next.
+     */
+    template<typename Derived>
+    Image GetResponse_(const Eigen::MatrixBase<Derived> &input) const
+    {
+        using Eigen::Index;
+
+        Index rows = input.rows();
+        Index columns = input.cols();
+        Index radius = this->smoothing_.size() / 2;
+        Image response(rows, columns);
+
+        Index bandRows = this->GetBandRows_(rows, columns);
+        Index bandCount = (rows + bandRows - 1) / bandRows;
+
+        auto chunks =
+            chunk::MakeThreadChunks(this->settings_.threads, bandCount);
+
+        chunk::RunChunks(
+            chunks,
+            [&](size_t chunkIndex)
+            {
+                auto &chunk = chunks[chunkIndex];
+                Workspace w(bandRows + 2 * radius, columns);
+                Index endBand = chunk.index + chunk.count;
+
+                // The rows held by the filtered buffers.
+                Index heldRow = 0;
+                Index heldCount = 0;
+
+                for (Index band = chunk.index; band < endBand; ++band)
+                {
+                    Index firstRow = band * bandRows;
+                    Index rowCount = std::min(bandRows, rows - firstRow);
+                    Index haloRow = std::max(Index{0}, firstRow - radius);
+
+                    Index haloCount =
+                        std::min(rows, firstRow + rowCount + radius)
+                        - haloRow;
+
+                    Index kept = std::max(
+                        Index{0},
+                        heldRow + heldCount - haloRow);
+
+                    if (kept > 0)
+                    {
+                        Index skipped = haloRow - heldRow;
+                        ShiftRows_(w.smoothed, skipped, kept);
+                        ShiftRows_(w.derivative, skipped, kept);
+                        ShiftRows_(w.secondDerivative, skipped, kept);
+                    }
+
+                    Index newCount = haloCount - kept;
+
+                    w.image.topRows(newCount) =
+                        input.middleRows(haloRow + kept, newCount)
+                            .template cast<Float>();
+
+                    auto image = w.image.topRows(newCount);
+
+                    CorrelateRows_(
+                        this->smoothing_,
+                        image,
+                        w.smoothed.middleRows(kept, newCount));
+
+                    CorrelateRows_(
+                        this->derivative_,
+                        image,
+                        w.derivative.middleRows(kept, newCount));
+
+                    CorrelateRows_(
+                        this->secondDerivative_,
+                        image,
+                        w.secondDerivative.middleRows(kept, newCount));
+
+                    heldRow = haloRow;
+                    heldCount = haloCount;
+
+                    Index rowOffset = firstRow - haloRow;
+
+                    CorrelateColumns_(
+                        this->smoothing_,
+                        w.secondDerivative.topRows(haloCount),
+                        rowOffset,
+                        rowCount,
+                        w.xx);
+
+                    CorrelateColumns_(
+                        this->secondDerivative_,
+                        w.smoothed.topRows(haloCount),
+                        rowOffset,
+                        rowCount,
+                        w.yy);
+
+                    CorrelateColumns_(
+                        this->derivative_,
+                        w.derivative.topRows(haloCount),
+                        rowOffset,
+                        rowCount,
+                        w.xy);
+
+                    response.middleRows(firstRow, rowCount).array() =
+                        (w.xy.array().square() - w.xx.array() * w.yy.array())
+                            .max(Float(0));
+                }
+            });
+
+        return response;
+    }
+
+    // Moves count rows, starting at first, to the top of the buffer.
+    static void ShiftRows_(
+        Image &buffer,
+        Eigen::Index first,
+        Eigen::Index count)
+    {
+        if (first == 0)
+        {
+            return;
+        }
+
+        // Rows are contiguous, and the destination precedes the source.
+        auto begin = buffer.data() + first * buffer.cols();
+        std::copy(begin, begin + count * buffer.cols(), buffer.data());
+    }
+
+    // Correlates each row with the kernel, treating values beyond the image
+    // edges as zero.
+    template<typename Input, typename Output>
+    static void CorrelateRows_(
+        const Kernel &kernel,
+        const Eigen::MatrixBase<Input> &input,
+        Output &&output)
+    {
+        using Eigen::Index;
+
+        Index columns = input.cols();
+        Index radius = kernel.size() / 2;
+        output.setZero();
+
+        for (Index tap = 0; tap < kernel.size(); ++tap)
+        {
+            Index offset = tap - radius;
+            Index first = std::max(Index{0}, -offset);
+            Index end = std::min(columns, columns - offset);
+
+            if (end <= first)
+            {
+                continue;
+            }
+
+            output.middleCols(first, end - first).array() +=
+                kernel(tap)
+                * input.middleCols(first + offset, end - first).array();
+        }
+    }
+
+    // Correlates the columns of rowCount rows, starting at firstRow, with the
+    // kernel. The input holds every row within reach of the kernel that is
+    // in the image.
+    template<typename Input>
+    static void CorrelateColumns_(
+        const Kernel &kernel,
+        const Eigen::MatrixBase<Input> &input,
+        Eigen::Index firstRow,
+        Eigen::Index rowCount,
+        Image &output)
+    {
+        using Eigen::Index;
+
+        Index radius = kernel.size() / 2;
+        output = Image::Zero(rowCount, input.cols());
+
+        for (Index row = 0; row < rowCount; ++row)
+        {
+            for (Index tap = 0; tap < kernel.size(); ++tap)
+            {
+                Index source = firstRow + row + tap - radius;
+
+                if (source < 0 || source >= input.rows())
+                {
+                    continue;
+                }
+
+                output.row(row) += kernel(tap) * input.row(source);
+            }
+        }
+    }
+
+    // Correlates the input with the separable kernel at one pixel.
+    template<typename Derived>
+    static double CorrelatePoint_(
+        const Kernel &rowKernel,
+        const Kernel &columnKernel,
+        const Eigen::MatrixBase<Derived> &input,
+        Eigen::Index row,
+        Eigen::Index column)
+    {
+        using Eigen::Index;
+
+        Index radius = rowKernel.size() / 2;
+        double result = 0;
+
+        for (Index i = 0; i < columnKernel.size(); ++i)
+        {
+            Index sourceRow = row + i - radius;
+
+            if (sourceRow < 0 || sourceRow >= input.rows())
+            {
+                continue;
+            }
+
+            double rowSum = 0;
+
+            for (Index j = 0; j < rowKernel.size(); ++j)
+            {
+                Index sourceColumn = column + j - radius;
+
+                if (sourceColumn >= 0 && sourceColumn < input.cols())
+                {
+                    rowSum += static_cast<double>(rowKernel(j))
+                        * static_cast<double>(input(sourceRow, sourceColumn));
+                }
+            }
+
+            result += static_cast<double>(columnKernel(i)) * rowSum;
+        }
+
+        return result;
+    }
+
+    // Takes one Newton step toward the point where the gradient vanishes.
+    // Steps longer than a pixel are rejected.
+    template<typename Derived>
+    tau::Point2d<double> Refine_(
+        const Eigen::MatrixBase<Derived> &input,
+        Eigen::Index row,
+        Eigen::Index column) const
+    {
+        auto x = static_cast<double>(column);
+        auto y = static_cast<double>(row);
+
+        auto correlate =
+            [&](const Kernel &rowKernel, const Kernel &columnKernel)
+            {
+                return CorrelatePoint_(
+                    rowKernel,
+                    columnKernel,
+                    input,
+                    row,
+                    column);
+            };
+
+        double dx = correlate(this->derivative_, this->smoothing_);
+        double dy = correlate(this->smoothing_, this->derivative_);
+        double xx = correlate(this->secondDerivative_, this->smoothing_);
+        double yy = correlate(this->smoothing_, this->secondDerivative_);
+        double xy = correlate(this->derivative_, this->derivative_);
+
+        // Negative at every saddle.
+        double determinant = xx * yy - xy * xy;
+
+        if (determinant >= 0)
+        {
+            return {x, y};
+        }
+
+        double stepX = -(yy * dx - xy * dy) / determinant;
+        double stepY = -(xx * dy - xy * dx) / determinant;
+
+        if (std::abs(stepX) > 1.0 || std::abs(stepY) > 1.0)
+        {
+            return {x, y};
+        }
+
+        return {x + stepX, y + stepY};
+    }
+
+    SaddleSettings settings_;
+    Kernel smoothing_;
+    Kernel derivative_;
+    Kernel secondDerivative_;
+};
+
+
+extern template class Saddle<float>;
+extern template class Saddle<double>;
+
+
+template<typename Float>
+using ThreadsafeSaddle = ThreadsafeFilter<SaddleGroup, Saddle<Float>>;
+
+
+} // end namespace iris
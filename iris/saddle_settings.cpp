@@ -0,0 +1,10 @@
+#include "iris/saddle_settings.h"
+
+
+
+template struct pex::Group
+    <
+        iris::SaddleFields,
+        iris::SaddleTemplate,
+        iris::SaddleCustom
+    >;
@@ -0,0 +1,106 @@
+#pragma once
+
+
+#include <fields/fields.h>
+#include <pex/group.h>
+#include <pex/range.h>
+#include <tau/eigen_shim.h>
+
+
+namespace iris
+{
+
+
+template<typename T>
+struct SaddleFields
+{
+    static constexpr auto fields = std::make_tuple(
+        fields::Field(&T::enable, "enable"),
+        fields::Field(&T::sigma, "sigma"),
+        fields::Field(&T::threshold, "threshold"),
+        fields::Field(&T::window, "window"),
+        fields::Field(&T::threads, "threads"));
+};
+
+
+template<template<typename> typename T>
+struct SaddleTemplate
+{
+    using SigmaLow = pex::Limit<0, 50, 100>;
+    using SigmaHigh = pex::Limit<10>;
+
+    using ThresholdLow = pex::Limit<0>;
+    using ThresholdHigh = pex::Limit<0, 50, 100>;
+
+    using WindowLow = pex::Limit<2>;
+    using WindowHigh = pex::Limit<64>;
+
+    T<bool> enable;
+    T<pex::MakeRange<double, SigmaLow, SigmaHigh>> sigma;
+
+    // Relative to the strongest saddle in the image.
+    T<pex::MakeRange<double, ThresholdLow, ThresholdHigh>> threshold;
+
+    // Saddles closer than the window are suppressed.
+    T<pex::MakeRange<Eigen::Index, WindowLow, WindowHigh>> window;
+
+    T<size_t> threads;
+
+    static constexpr auto fields =
+        SaddleFields<SaddleTemplate>::fields;
+
+    static constexpr auto fieldsTypeName = "Saddle";
+};
+
+
+struct SaddleCustom
+{
+    template<typename Base>
+    struct Plain: public Base
+    {
+        static constexpr double defaultSigma = 2.0;
+        static constexpr double defaultThreshold = 0.05;
+        static constexpr Eigen::Index defaultWindow = 10;
+        static constexpr size_t defaultThreads = 4;
+
+        Plain()
+            :
+            Base{
+                true,
+                defaultSigma,
+                defaultThreshold,
+                defaultWindow,
+                defaultThreads}
+        {
+
+        }
+    };
+};
+
+
+using SaddleGroup = pex::Group
+    <
+        SaddleFields,
+        SaddleTemplate,
+        SaddleCustom
+    >;
+
+
+using SaddleSettings = typename SaddleGroup::Plain;
+using SaddleModel = typename SaddleGroup::Model;
+using SaddleControl = typename SaddleGroup::DefaultControl;
+
+
+DECLARE_OUTPUT_STREAM_OPERATOR(SaddleSettings)
+DECLARE_EQUALITY_OPERATORS(SaddleSettings)
+
+
+} // end namespace iris
+
+
+extern template struct pex::Group
+    <
+        iris::SaddleFields,
+        iris::SaddleTemplate,
+        iris::SaddleCustom
+    >;
@@ -1,6 +1,11 @@
 #pragma once
 
 
+#include <algorithm>
+#include <cmath>
+#include <tuple>
+#include <utility>
+#include <vector>
 #include <fields/fields.h>
 #include <pex/interface.h>
 #include <pex/group.h>
@@ -9,17 +14,68 @@
 #include <tau/eigen.h>
 
 #include "iris/detail/suppression_detail.h"
+#include "iris/detail/running_maximum.h"
+#include "iris/detail/sparse_suppression.h"
 
 
 namespace iris
 {
 
 
+template<typename Scalar>
+using LocalMaximum = detail::LocalMaximumTemplate<Scalar>;
+
+
+template<typename Scalar>
+using LocalMaxima = std::vector<LocalMaximum<Scalar>>;
+
+
+/*
+ * Keeps each non-zero value that is the maximum of every windowSize by
+ * windowSize window that contains it, and zeros the rest.
+ *
+ * The output is split into tiles that are suppressed in parallel. Each tile
+ * reads a halo of windowSize - 1 around itself from the read-only input,
+ * and writes only its own values, so the result is exact without a second
+ * pass over the seams, for any thread count.
+ *
+ * Within a tile, the local maxima come from a separable van Herk/Gil-Werman
+ * running maximum, so the cost per value does not depend on windowSize.
+ * The same passes count the values equal to each maximum, which finds the
+ * equal maxima described below.
+ *
+ * Equal maxima within a window of each other are visited in the storage
+ * order of Output. The first is kept, and a later one is suppressed only if
+ * a kept maximum is within its window. Because that choice can chain across
+ * tiles, the tiles set these maxima aside, and Wait() decides them after
+ * the tiles are done.
+ */
 template<typename Input, typename Output>
 class AsyncSuppression
 {
 public:
     using Index = typename Eigen::Index;
+    using Scalar = typename Output::Scalar;
+    using Maxima = LocalMaxima<Scalar>;
+
+    // Each column is a column of a tile and its halo.
+    using Lines = Eigen::Array<Scalar, Eigen::Dynamic, Eigen::Dynamic>;
+    using Count = detail::RunningMaximum::Count;
+    using Counts = detail::RunningMaximum::Counts;
+
+    struct Tile
+    {
+        Index row;
+        Index column;
+        Index rowCount;
+        Index columnCount;
+    };
+
+    // Tiles smaller than this are not worth their halos.
+    static constexpr Index minimumTileSize = 16;
+
+    // Tiles are at least four windows wide when there are enough of them.
+    static constexpr Index preferredTileSize = 64;
 
     AsyncSuppression(
         size_t threadCount,
@@ -27,232 +83,428 @@ public:
         const Eigen::MatrixBase<Input> &input,
         Eigen::MatrixBase<Output> &output)
         :
-        threadCount_(threadCount),
+        threadCount_(std::max(threadCount, size_t{1})),
         windowSize_(windowSize),
+        reach_(windowSize - 1),
         rows_(input.rows()),
         columns_(input.cols()),
-        suppressionChunks_(),
+        runningMaximum_(windowSize - 1),
+        tiles_(),
+        ties_(),
+        sentries_(),
+        input_(input),
         output_(output)
     {
-        Index maximumThreadCount;
-
-        if constexpr (tau::MatrixTraits<Output>::isColumnMajor)
-        {
-            maximumThreadCount = this->columns_ / windowSize;
-        }
-        else
+        if (windowSize < 1)
         {
-            maximumThreadCount = this->rows_ / windowSize;
+            throw IrisError("windowSize must be at least 1.");
         }
 
         // Ensure that output has the right size.
-        // Leave the values uninitialized for now.
+        // Every value is written by exactly one tile.
         this->output_ = Output(this->rows_, this->columns_);
 
-        this->threadCount_ =
-            std::min(static_cast<size_t>(maximumThreadCount), threadCount);
+        this->tiles_ = this->MakeTiles_();
 
-        this->chunks_ = this->MakeChunks_();
+        auto chunks = chunk::MakeThreadChunks(
+            this->threadCount_,
+            static_cast<Index>(this->tiles_.size()));
 
-        if (this->chunks_.at(0).count < windowSize)
+        this->ties_.resize(chunks.size());
+        this->sentries_.reserve(chunks.size());
+        auto threadPool = jive::GetThreadPool();
+
+        for (auto index: jive::Range<size_t>(0, chunks.size()))
         {
-            throw IrisError("Chunk width is smaller than window size.");
+            auto chunk = chunks[index];
+
+            this->sentries_.emplace_back(
+                threadPool->AddJob(
+                    [this, chunk, index]()
+                    {
+                        Index end = chunk.index + chunk.count;
+
+                        for (Index tile = chunk.index; tile < end; ++tile)
+                        {
+                            this->SuppressTile_(
+                                this->tiles_[static_cast<size_t>(tile)],
+                                this->ties_[index]);
+                        }
+                    }));
         }
+    }
+
+    void Wait()
+    {
+        chunk::AwaitThreads(this->sentries_);
 
-        this->suppressionChunks_.reserve(this->chunks_.size());
+        Maxima ties;
 
-        if constexpr (tau::MatrixTraits<Output>::isColumnMajor)
+        for (auto &tileTies: this->ties_)
         {
-            if (this->rows_ < windowSize)
-            {
-                throw IrisError("Chunk height is smaller than window size.");
-            }
+            ties.insert(ties.end(), tileTies.begin(), tileTies.end());
+        }
 
-            for (auto &chunk: this->chunks_)
+        if (ties.empty())
+        {
+            return;
+        }
+
+        std::sort(
+            ties.begin(),
+            ties.end(),
+            [](const auto &first, const auto &second)
             {
-                this->suppressionChunks_.emplace_back(
-                    chunk,
-                    chunk::Chunk{0, this->columns_},
-                    windowSize,
-                    input,
-                    output);
-            }
+                if constexpr (tau::MatrixTraits<Output>::isColumnMajor)
+                {
+                    return std::tie(first.column, first.row)
+                        < std::tie(second.column, second.row);
+                }
+                else
+                {
+                    return std::tie(first.row, first.column)
+                        < std::tie(second.row, second.column);
+                }
+            });
+
+        // Every tie is a local maximum, so the sparse suppressor only has
+        // to choose between equals.
+        auto kept = detail::SparseSuppressor<Scalar>(
+            this->windowSize_,
+            this->rows_,
+            this->columns_)(ties, this->threadCount_);
+
+        for (auto &maximum: kept)
+        {
+            this->output_(maximum.row, maximum.column) = maximum.value;
         }
-        else
+    }
+
+private:
+    std::vector<Tile> MakeTiles_() const
+    {
+        std::vector<Tile> tiles;
+
+        if (this->rows_ == 0 || this->columns_ == 0)
         {
-            if (this->columns_ < windowSize)
-            {
-                throw IrisError("Chunk height is smaller than window size.");
-            }
+            return tiles;
+        }
 
-            for (auto &chunk: this->chunks_)
+        // Prefer tiles that are large compared to their halos, unless that
+        // would leave threads idle.
+        auto threads = static_cast<double>(this->threadCount_);
+
+        auto sizeForThreads = static_cast<Index>(
+            std::sqrt(
+                static_cast<double>(this->rows_ * this->columns_) / threads));
+
+        Index tileSize = std::max(
+            minimumTileSize,
+            std::min(
+                std::max(preferredTileSize, 4 * this->windowSize_),
+                sizeForThreads));
+
+        for (Index row = 0; row < this->rows_; row += tileSize)
+        {
+            for (Index column = 0; column < this->columns_; column += tileSize)
             {
-                this->suppressionChunks_.emplace_back(
-                    chunk::Chunk{0, this->rows_},
-                    chunk,
-                    windowSize,
-                    input,
-                    output);
+                tiles.push_back(
+                    Tile{
+                        row,
+                        column,
+                        std::min(tileSize, this->rows_ - row),
+                        std::min(tileSize, this->columns_ - column)});
             }
         }
+
+        return tiles;
     }
 
-    void Wait()
+    void SuppressTile_(const Tile &tile, Maxima &ties)
     {
-        for (auto &chunk: this->suppressionChunks_)
+        Index haloRow = std::max(Index{0}, tile.row - this->reach_);
+        Index haloColumn = std::max(Index{0}, tile.column - this->reach_);
+
+        Index haloRowCount =
+            std::min(this->rows_, tile.row + tile.rowCount + this->reach_)
+            - haloRow;
+
+        Index haloColumnCount =
+            std::min(
+                this->columns_,
+                tile.column + tile.columnCount + this->reach_)
+            - haloColumn;
+
+        Lines values = this->input_.block(
+            haloRow,
+            haloColumn,
+            haloRowCount,
+            haloColumnCount).template cast<Scalar>().array();
+
+        // Down each column, then across the columns.
+        Lines alongColumns(haloRowCount, haloColumnCount);
+        Counts alongCounts(haloRowCount, haloColumnCount);
+        Lines maxima(haloRowCount, haloColumnCount);
+        Counts maximaCounts(haloRowCount, haloColumnCount);
+
+        auto paddedCount = this->runningMaximum_.GetPaddedCount(haloRowCount);
+        auto paddedSize = static_cast<size_t>(paddedCount);
+        std::vector<Scalar> forward(paddedSize);
+        std::vector<Count> forwardCounts(paddedSize);
+        std::vector<Scalar> backward(paddedSize);
+        std::vector<Count> backwardCounts(paddedSize);
+
+        for (Index column = 0; column < haloColumnCount; ++column)
         {
-            chunk.Wait();
+            this->runningMaximum_.Along(
+                &values(0, column),
+                &alongColumns(0, column),
+                &alongCounts(0, column),
+                haloRowCount,
+                forward.data(),
+                forwardCounts.data(),
+                backward.data(),
+                backwardCounts.data());
         }
 
-        if (this->threadCount_ > 1)
+        paddedCount = this->runningMaximum_.GetPaddedCount(haloColumnCount);
+        Lines forwardColumns(haloRowCount, paddedCount);
+        Counts forwardColumnCounts(haloRowCount, paddedCount);
+        Lines backwardColumns(haloRowCount, paddedCount);
+        Counts backwardColumnCounts(haloRowCount, paddedCount);
+
+        this->runningMaximum_.Across(
+            alongColumns,
+            alongCounts,
+            maxima,
+            maximaCounts,
+            0,
+            haloRowCount,
+            forwardColumns,
+            forwardColumnCounts,
+            backwardColumns,
+            backwardColumnCounts);
+
+        Index rowOffset = tile.row - haloRow;
+        Index columnOffset = tile.column - haloColumn;
+
+        auto interior = this->output_.block(
+            tile.row,
+            tile.column,
+            tile.rowCount,
+            tile.columnCount);
+
+        interior.setZero();
+
+        for (Index column = 0; column < tile.columnCount; ++column)
         {
-            if constexpr (tau::MatrixTraits<Output>::isColumnMajor)
-            {
-                this->ZipColumnMajor_();
-            }
-            else
+            for (Index row = 0; row < tile.rowCount; ++row)
             {
-                this->ZipRowMajor_();
+                Index inHaloRow = row + rowOffset;
+                Index inHaloColumn = column + columnOffset;
+                Scalar value = values(inHaloRow, inHaloColumn);
+
+                if (value == 0 || value != maxima(inHaloRow, inHaloColumn))
+                {
+                    continue;
+                }
+
+                // The window of this value lies within the halo, and other
+                // values in it equal this one.
+                if (maximaCounts(inHaloRow, inHaloColumn) > 1)
+                {
+                    ties.push_back(
+                        {tile.column + column, tile.row + row, value});
+                }
+                else
+                {
+                    interior(row, column) = value;
+                }
             }
         }
     }
 
 private:
-    chunk::Chunks MakeChunks_() const
-    {
-        if constexpr (tau::MatrixTraits<Output>::isColumnMajor)
-        {
-            // Create chunks along the columns
-            auto chunks =
-                chunk::MakeChunks(
-                    this->threadCount_,
-                    this->rows_,
-                    this->windowSize_);
-
-            assert(chunks.back().count >= chunks.at(0).count);
+    size_t threadCount_;
+    Index windowSize_;
+    Index reach_;
+    Index rows_;
+    Index columns_;
+    detail::RunningMaximum runningMaximum_;
+    std::vector<Tile> tiles_;
+    std::vector<Maxima> ties_;
+    std::vector<jive::Sentry> sentries_;
+    const Eigen::MatrixBase<Input> &input_;
+    Eigen::MatrixBase<Output> &output_;
+};
 
-            return chunks;
-        }
-        else
-        {
-            // Create chunks along the rows
-            auto chunks =
-                chunk::MakeChunks(
-                    this->threadCount_,
-                    this->columns_,
-                    this->windowSize_);
 
-            assert(chunks.back().count >= chunks.at(0).count);
+namespace detail
+{
 
-            return chunks;
-        }
-    }
 
-    void ZipColumnMajor_()
-    {
-        assert(this->threadCount_ >= 2);
+// Lists the non-zero values of input in column-major or row-major order.
+template<typename Scalar, bool isColumnMajor, typename Input>
+std::vector<LocalMaximumTemplate<Scalar>> CollectCandidates(
+    size_t threadCount,
+    const Eigen::MatrixBase<Input> &input)
+{
+    using Eigen::Index;
+    using Candidates = std::vector<LocalMaximumTemplate<Scalar>>;
 
-        // Zip up the boundary
-        // Each thread applied the suppression window up to the boundary.
-        // We need to apply the window to the seam, extending a full window
-        // height or width into the neighboring region.
-        auto chunkPtr = std::begin(this->chunks_);
+    Index lineCount = isColumnMajor ? input.cols() : input.rows();
+    Index lineSize = isColumnMajor ? input.rows() : input.cols();
 
-        auto threadPool = jive::GetThreadPool();
-        std::vector<jive::Sentry> sentries;
-        sentries.reserve(this->chunks_.size() - 1);
+    auto chunks = chunk::MakeThreadChunks(threadCount, lineCount);
+    std::vector<Candidates> found(chunks.size());
 
-        // We will look backwards starting at the second chunkPtr.
-        while (++chunkPtr != std::end(this->chunks_))
+    chunk::RunChunks(
+        chunks,
+        [&](size_t chunkIndex)
         {
-            auto chunk = *chunkPtr;
+            auto &chunk = chunks[chunkIndex];
+            auto &candidates = found[chunkIndex];
+            Index end = chunk.index + chunk.count;
 
-            sentries.emplace_back(
-                threadPool->AddJob(
-                    [chunk, this]()
+            for (Index line = chunk.index; line < end; ++line)
+            {
+                for (Index offset = 0; offset < lineSize; ++offset)
+                {
+                    Index row = isColumnMajor ? offset : line;
+                    Index column = isColumnMajor ? line : offset;
+
+                    auto value =
+                        static_cast<Scalar>(input.derived().coeff(row, column));
+
+                    if (value != 0)
                     {
-                        Index zipBegin = chunk.index - this->windowSize_ + 1;
-                        Index zipSize = 2 * (this->windowSize_ - 1);
-
-                        auto block = this->output_.block(
-                            zipBegin,
-                            0,
-                            zipSize,
-                            this->columns_);
-
-                        detail::Suppress(
-                            zipSize - this->windowSize_ + 1,
-                            this->columns_ - this->windowSize_ + 1,
-                            this->windowSize_,
-                            tau::MakeView(block));
-                    }));
-        }
+                        candidates.push_back({column, row, value});
+                    }
+                }
+            }
+        });
 
-        for (auto &sentry: sentries)
-        {
-            sentry.Wait();
-        }
+    if (found.empty())
+    {
+        return {};
     }
 
-    void ZipRowMajor_()
+    Candidates result = std::move(found.front());
+
+    for (size_t index = 1; index < found.size(); ++index)
     {
-        assert(this->threadCount_ >= 2);
+        result.insert(result.end(), found[index].begin(), found[index].end());
+    }
 
-        // Zip up the boundary
-        // Each thread applied the suppression window up to the boundary.
-        // We need to apply the window to the seam, extending a full window
-        // height or width into the neighboring region.
-        auto chunkPtr = std::begin(this->chunks_);
+    return result;
+}
 
-        auto threadPool = jive::GetThreadPool();
-        std::vector<jive::Sentry> sentries;
-        sentries.reserve(this->chunks_.size() - 1);
 
-        // We will look backwards starting at the second chunkPtr.
-        while (++chunkPtr != std::end(this->chunks_))
-        {
-            auto chunk = *chunkPtr;
+template<typename Scalar, bool isColumnMajor, typename Input>
+std::vector<LocalMaximumTemplate<Scalar>> FindLocalMaxima(
+    size_t threadCount,
+    Eigen::Index windowSize,
+    const Eigen::MatrixBase<Input> &input)
+{
+    if (windowSize < 1)
+    {
+        throw IrisError("windowSize must be at least 1.");
+    }
 
-            sentries.emplace_back(
-                threadPool->AddJob(
-                    [chunk, this]()
-                    {
-                        Index zipBegin = chunk.index - this->windowSize_ + 1;
-                        Index zipSize = 2 * (this->windowSize_ - 1);
-
-                        auto block = this->output_.block(
-                            0,
-                            zipBegin,
-                            this->rows_,
-                            zipSize);
-
-                        detail::Suppress(
-                            this->rows_ - this->windowSize_ + 1,
-                            zipSize - this->windowSize_ + 1,
-                            this->windowSize_,
-                            tau::MakeView(block));
-                    }));
-        }
+    auto candidates =
+        CollectCandidates<Scalar, isColumnMajor>(threadCount, input);
 
-        for (auto &sentry: sentries)
-        {
-            sentry.Wait();
-        }
+    return SparseSuppressor<Scalar>(
+        windowSize,
+        input.rows(),
+        input.cols())(candidates, threadCount);
+}
+
+
+} // end namespace detail
+
+
+// Lists the non-zero values of input in its storage order.
+template<typename Input>
+LocalMaxima<typename Input::Scalar> ListNonZero(
+    size_t threadCount,
+    const Eigen::MatrixBase<Input> &input)
+{
+    return detail::CollectCandidates
+        <
+            typename Input::Scalar,
+            tau::MatrixTraits<Input>::isColumnMajor
+        >(threadCount, input);
+}
+
+
+/*
+ * Lists the values that SparseSuppression would keep, in the storage order
+ * of input, without writing a dense result.
+ */
+template<typename Input>
+LocalMaxima<typename Input::Scalar> FindLocalMaxima(
+    size_t threadCount,
+    Eigen::Index windowSize,
+    const Eigen::MatrixBase<Input> &input)
+{
+    return detail::FindLocalMaxima
+        <
+            typename Input::Scalar,
+            tau::MatrixTraits<Input>::isColumnMajor
+        >(threadCount, windowSize, input);
+}
+
+
+// Writes maxima into a zeroed dense matrix.
+template<typename Scalar, typename Output>
+void MaximaToMatrix(
+    const LocalMaxima<Scalar> &maxima,
+    Eigen::Index rows,
+    Eigen::Index columns,
+    Eigen::MatrixBase<Output> &output)
+{
+    output = Output::Zero(rows, columns);
+
+    for (auto &maximum: maxima)
+    {
+        output(maximum.row, maximum.column) =
+            static_cast<typename Output::Scalar>(maximum.value);
     }
+}
 
-private:
-    size_t threadCount_;
-    Index windowSize_;
-    Index rows_;
-    Index columns_;
-    std::vector<detail::SuppressionChunk<Input, Output>> suppressionChunks_;
-    chunk::Chunks chunks_;
-    Eigen::MatrixBase<Output> &output_;
-};
 
+/*
+ * Produces the same result as Suppression, working only on the
+ * non-zero values of input.
+ *
+ * After one pass to list the non-zero values, the cost scales with their
+ * count rather than with the size of input, which suits thresholded
+ * responses where most values are zero.
+ */
+template<typename Input, typename Output>
+void SparseSuppression(
+    size_t threadCount,
+    Eigen::Index windowSize,
+    const Eigen::MatrixBase<Input> &input,
+    Eigen::MatrixBase<Output> &output)
+{
+    using Scalar = typename Output::Scalar;
+
+    auto maxima = detail::FindLocalMaxima
+        <
+            Scalar,
+            tau::MatrixTraits<Output>::isColumnMajor
+        >(threadCount, windowSize, input);
+
+    MaximaToMatrix(maxima, input.rows(), input.cols(), output);
+}
 
+
+// Suppresses with the running maximum of AsyncSuppression, and waits for
+// the result.
 template<typename Input, typename Output>
-void Suppression(
+void MaximumSuppression(
     size_t threadCount,
     Eigen::Index windowSize,
     const Eigen::MatrixBase<Input> &input,
@@ -262,4 +514,15 @@ void Suppression(
 }
 
 
+template<typename Input, typename Output>
+void Suppression(
+    size_t threadCount,
+    Eigen::Index windowSize,
+    const Eigen::MatrixBase<Input> &input,
+    Eigen::MatrixBase<Output> &output)
+{
+    MaximumSuppression(threadCount, windowSize, input, output);
+}
+
+
 } // end namespace iris
@@ -1,5 +1,9 @@
 #include "iris/vertex.h"
 #include <algorithm>
+#include <cmath>
+#include <functional>
+#include <iterator>
+#include <numeric>
 
 
 namespace iris
@@ -10,9 +14,12 @@ namespace detail
 {
 
 
-std::optional<Vertex> GetCentroid(size_t count, const ValuePoints &points)
+std::optional<tau::Point2d<double>> GetCentroid(
+    size_t count,
+    ValuePoints::const_iterator first,
+    ValuePoints::const_iterator last)
 {
-    auto pointsSize = points.size();
+    auto pointsSize = static_cast<size_t>(std::distance(first, last));
 
     if (pointsSize == 0)
     {
@@ -35,30 +42,54 @@ std::optional<Vertex> GetCentroid(size_t count, const ValuePoints &points)
     double centroidY = 0;
     auto pointCount = static_cast<double>(pointsSize);
 
-    for (auto &point: points)
+    for (auto point = first; point != last; ++point)
     {
-        centroidX += point.x;
-        centroidY += point.y;
+        centroidX += point->x;
+        centroidY += point->y;
     }
 
-    return Vertex(
+    return tau::Point2d<double>(
         centroidX / pointCount,
-        centroidY / pointCount,
-        points);
+        centroidY / pointCount);
 }
 
 
-Vertices PointGroups::GetVertices() const
+PointGroups::PointGroups(double radius, size_t count)
+    :
+    radiusSquared_(radius * radius),
+    cellSize_(std::max(radius, 1.0)),
+    count_(count),
+    seeds_(),
+    groupsByCell_(),
+    points_(),
+    groupIndices_(),
+    groupPoints_(),
+    groupOffsets_(),
+    groupOrder_()
+{
+
+}
+
+
+VertexSet PointGroups::GetVertices() const
 {
-    Vertices result;
+    VertexSet result;
+    result.Reserve(this->groupOrder_.size(), this->groupPoints_.size());
 
-    for (const auto &entry: this->pointGroupByPoint_)
+    for (auto groupIndex: this->groupOrder_)
     {
-        auto centroid = GetCentroid(this->count_, entry.second);
+        auto first = std::cbegin(this->groupPoints_)
+            + static_cast<std::ptrdiff_t>(this->groupOffsets_[groupIndex]);
+
+        auto last = std::cbegin(this->groupPoints_)
+            + static_cast<std::ptrdiff_t>(
+                this->groupOffsets_[groupIndex + 1]);
+
+        auto centroid = GetCentroid(this->count_, first, last);
 
         if (centroid)
         {
-            result.push_back(*centroid);
+            result.Add(*centroid, first, last);
         }
     }
 
@@ -66,111 +97,266 @@ Vertices PointGroups::GetVertices() const
 }
 
 
+size_t PointGroups::CellHash::operator()(const Cell &cell) const
+{
+    auto column = static_cast<uint64_t>(cell.first);
+    auto row = static_cast<uint64_t>(cell.second);
+
+    return std::hash<uint64_t>()(column * 0x9E3779B97F4A7C15ull ^ row);
+}
+
+
+PointGroups::Cell PointGroups::GetCell_(
+    const tau::Point2d<double> &point) const
+{
+    return {
+        static_cast<int64_t>(std::floor(point.x / this->cellSize_)),
+        static_cast<int64_t>(std::floor(point.y / this->cellSize_))};
+}
+
+
 void PointGroups::AddPoint_(const draw::ValuePoint<double> &point)
 {
-    for (auto &entry: this->pointGroupByPoint_)
+    // A first point within radius is at most one cell away.
+    auto [cellColumn, cellRow] = this->GetCell_(point);
+    std::optional<size_t> joined;
+
+    for (auto row = cellRow - 1; row <= cellRow + 1; ++row)
     {
-        // Use SquaredSum to avoid sqrt.
-        if ((point - entry.first).SquaredSum() < this->radiusSquared_)
+        for (auto column = cellColumn - 1; column <= cellColumn + 1; ++column)
         {
-            entry.second.push_back(point);
-            return;
+            auto cell = this->groupsByCell_.find({column, row});
+
+            if (cell == std::end(this->groupsByCell_))
+            {
+                continue;
+            }
+
+            for (auto groupIndex: cell->second)
+            {
+                auto &seed = this->seeds_[groupIndex];
+
+                // Use SquaredSum to avoid sqrt.
+                if ((point - seed).SquaredSum() >= this->radiusSquared_)
+                {
+                    continue;
+                }
+
+                if (!joined || seed < this->seeds_[*joined])
+                {
+                    joined = groupIndex;
+                }
+            }
         }
     }
 
-    this->pointGroupByPoint_[point].push_back(point);
+    if (!joined)
+    {
+        joined = this->seeds_.size();
+        this->seeds_.push_back(point);
+        this->groupsByCell_[{cellColumn, cellRow}].push_back(*joined);
+    }
+
+    this->points_.push_back(point);
+    this->groupIndices_.push_back(*joined);
 }
 
 
-} // end namespace detail
+void PointGroups::NormalizeGroups_()
+{
+    auto groupCount = this->seeds_.size();
 
+    // Sort the points by group, keeping the order they were added.
+    this->groupOffsets_.assign(groupCount + 1, 0);
 
-std::vector<tau::Point2d<double>> VerticesToPoints(
-    const Vertices &vertices)
-{
-    std::vector<tau::Point2d<double>> result;
-    result.reserve(vertices.size());
+    for (auto groupIndex: this->groupIndices_)
+    {
+        ++this->groupOffsets_[groupIndex + 1];
+    }
+
+    for (size_t groupIndex = 1; groupIndex <= groupCount; ++groupIndex)
+    {
+        this->groupOffsets_[groupIndex] += this->groupOffsets_[groupIndex - 1];
+    }
+
+    this->groupPoints_.resize(this->points_.size());
+
+    std::vector<size_t> next(
+        std::begin(this->groupOffsets_),
+        std::prev(std::end(this->groupOffsets_)));
+
+    for (size_t index = 0; index < this->points_.size(); ++index)
+    {
+        this->groupPoints_[next[this->groupIndices_[index]]++] =
+            this->points_[index];
+    }
+
+    // Retain the top 4 values of each group, compacting the storage.
+    size_t retained = 0;
+
+    for (size_t groupIndex = 0; groupIndex < groupCount; ++groupIndex)
+    {
+        auto first = std::begin(this->groupPoints_)
+            + static_cast<std::ptrdiff_t>(this->groupOffsets_[groupIndex]);
+
+        auto last = std::begin(this->groupPoints_)
+            + static_cast<std::ptrdiff_t>(
+                this->groupOffsets_[groupIndex + 1]);
+
+        assert(first != last);
+
+        if (std::distance(first, last) > 4)
+        {
+            std::stable_sort(
+                first,
+                last,
+                [](const auto &left, const auto &right)
+                {
+                    return left.value > right.value;
+                });
+
+            last = first + 4;
+        }
+
+        double maximumValue = std::max_element(
+            first,
+            last,
+            [](const auto &left, const auto &right)
+            {
+                return left.value < right.value;
+            })->value;
+
+        this->groupOffsets_[groupIndex] = retained;
 
-    std::transform(
-        std::begin(vertices),
-        std::end(vertices),
-        std::back_inserter(result),
-        [](const Vertex &vertex)
+        for (auto it = first; it != last; ++it)
         {
-            return vertex.point;
+            auto &point = this->groupPoints_[retained++];
+            point = *it;
+            point.value /= maximumValue;
+        }
+    }
+
+    this->groupOffsets_[groupCount] = retained;
+    this->groupPoints_.resize(retained);
+
+    this->groupOrder_.resize(groupCount);
+    std::iota(std::begin(this->groupOrder_), std::end(this->groupOrder_), 0);
+
+    std::sort(
+        std::begin(this->groupOrder_),
+        std::end(this->groupOrder_),
+        [this](size_t first, size_t second)
+        {
+            return this->seeds_[first] < this->seeds_[second];
         });
+}
+
+
+} // end namespace detail
+
+
+VertexSet::VertexSet()
+    :
+    x(),
+    y(),
+    count(),
+    keys(),
+    offsets{0},
+    valuePoints()
+{
 
-    return result;
 }
 
 
-ValuePoints VerticesToValuePoints(const Vertices &vertices)
+size_t VertexSet::size() const
 {
-    ValuePoints valuePoints;
+    return this->x.size();
+}
 
-    for (const auto &vertex: vertices)
-    {
-        valuePoints.insert(
-            std::end(valuePoints),
-            std::begin(vertex.valuePoints),
-            std::end(vertex.valuePoints));
-    }
 
-    return valuePoints;
+bool VertexSet::empty() const
+{
+    return this->x.empty();
 }
 
 
-Vertex::Vertex(
-    double x,
-    double y,
-    const ValuePoints &valuePoints_)
-    :
-    point(x, y),
-    count(valuePoints_.size()),
-    valuePoints(valuePoints_)
+void VertexSet::Clear()
 {
+    this->x.clear();
+    this->y.clear();
+    this->count.clear();
+    this->keys.clear();
+    this->offsets.assign(1, 0);
+    this->valuePoints.clear();
+}
 
 
+void VertexSet::Reserve(size_t vertexCount, size_t valuePointCount)
+{
+    this->x.reserve(vertexCount);
+    this->y.reserve(vertexCount);
+    this->count.reserve(vertexCount);
+    this->keys.reserve(vertexCount);
+    this->offsets.reserve(vertexCount + 1);
+    this->valuePoints.reserve(valuePointCount);
 }
 
 
-bool Vertex::operator>(const Vertex &other) const
+tau::Point2d<double> VertexSet::GetPoint(size_t index) const
 {
-    if (this->point.template Cast<int>()
-        == other.point.template Cast<int>())
+    return {this->x[index], this->y[index]};
+}
+
+
+std::vector<tau::Point2d<double>> VertexSet::GetPoints() const
+{
+    std::vector<tau::Point2d<double>> result;
+    result.reserve(this->size());
+
+    for (size_t index = 0; index < this->size(); ++index)
     {
-        return this->count > other.count;
+        result.push_back(this->GetPoint(index));
     }
 
-    return this->point.template Cast<int>()
-        > other.point.template Cast<int>();
+    return result;
 }
 
-bool Vertex::operator<(const Vertex &other) const
+
+ValuePoints VertexSet::GetValuePoints(size_t index) const
+{
+    auto first = std::cbegin(this->valuePoints);
+
+    return ValuePoints(
+        first + static_cast<std::ptrdiff_t>(this->offsets[index]),
+        first + static_cast<std::ptrdiff_t>(this->offsets[index + 1]));
+}
+
+
+bool VertexSet::IsLess(size_t first, size_t second) const
 {
-    if (this->point.template Cast<int>()
-        == other.point.template Cast<int>())
+    if (this->keys[first] == this->keys[second])
     {
-        return this->count < other.count;
+        return this->count[first] < this->count[second];
     }
 
-    return (this->point.template Cast<int>()
-        < other.point.template Cast<int>());
+    return this->keys[first] < this->keys[second];
 }
 
-// For the purpose of determining unique vertices, vertices with the same
-// point compare equal, even if their counts differ.
-bool Vertex::operator==(const Vertex &other) const
+
+bool VertexSet::IsGreater(size_t first, size_t second) const
 {
-    return (this->point.template Cast<int>()
-        == other.point.template Cast<int>());
+    if (this->keys[first] == this->keys[second])
+    {
+        return this->count[first] > this->count[second];
+    }
+
+    return this->keys[first] > this->keys[second];
 }
 
 
-std::ostream & operator<<(std::ostream &output, const Vertex &point)
+bool VertexSet::IsSame(size_t first, size_t second) const
 {
-    return output << "Vertex(point: " << point.point
-        << ", count: " << point.count << ")";
+    return this->keys[first] == this->keys[second];
 }
 
 
@@ -1,6 +1,12 @@
 #pragma once
 
 
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 #include <fields/fields.h>
 #include <pex/interface.h>
 #include <pex/range.h>
@@ -11,6 +17,7 @@
 #include <tau/mono_image.h>
 #include "iris/vertex_settings.h"
 #include "iris/threadsafe_filter.h"
+#include "iris/harris.h"
 
 
 namespace iris
@@ -20,124 +27,151 @@ namespace iris
 using ValuePoints = std::vector<draw::ValuePoint<double>>;
 
 
-struct Vertex
+/*
+ * Vertices in flat arrays, with the value points of every vertex in one
+ * shared array.
+ *
+ * The value points of vertex i are valuePoints[offsets[i]] to
+ * valuePoints[offsets[i + 1] - 1]. Each vertex has a key, its point cast to
+ * int, which orders the vertices and decides which are the same.
+ */
+struct VertexSet
 {
-    tau::Point2d<double> point;
-    double count;
-    ValuePoints valuePoints;
+    VertexSet();
 
-    Vertex(double x, double y, const ValuePoints &valuePoints_);
+    size_t size() const;
 
-    bool operator>(const Vertex &other) const;
+    bool empty() const;
 
-    bool operator<(const Vertex &other) const;
+    void Clear();
 
-    // For the purpose of determining unique vertices, vertices with the same
-    // point compare equal, even if their counts differ.
-    bool operator==(const Vertex &other) const;
-};
+    void Reserve(size_t vertexCount, size_t valuePointCount);
 
+    template<typename Iterator>
+    void Add(const tau::Point2d<double> &point, Iterator first, Iterator last)
+    {
+        this->x.push_back(point.x);
+        this->y.push_back(point.y);
+        this->count.push_back(static_cast<double>(std::distance(first, last)));
+        this->keys.push_back(point.template Cast<int>());
+        this->valuePoints.insert(std::end(this->valuePoints), first, last);
+        this->offsets.push_back(this->valuePoints.size());
+    }
+
+    tau::Point2d<double> GetPoint(size_t index) const;
 
-using Vertices = std::vector<Vertex>;
+    std::vector<tau::Point2d<double>> GetPoints() const;
 
+    // Copies the value points of one vertex.
+    ValuePoints GetValuePoints(size_t index) const;
 
-std::vector<tau::Point2d<double>> VerticesToPoints(const Vertices &);
-ValuePoints VerticesToValuePoints(const Vertices &);
+    // Vertices with the same key are ordered by count.
+    bool IsLess(size_t first, size_t second) const;
 
+    bool IsGreater(size_t first, size_t second) const;
 
-std::ostream & operator<<(std::ostream &, const Vertex &);
+    // For the purpose of determining unique vertices, vertices with the same
+    // key are the same, even if their counts differ.
+    bool IsSame(size_t first, size_t second) const;
+
+    std::vector<double> x;
+    std::vector<double> y;
+    std::vector<double> count;
+    std::vector<tau::Point2d<int>> keys;
+    std::vector<size_t> offsets;
+    ValuePoints valuePoints;
+};
 
 
 namespace detail
 {
 
 
-std::optional<Vertex> GetCentroid(size_t count, const ValuePoints &points);
+// Returns the centroid of a group of points, if the group can be a vertex.
+std::optional<tau::Point2d<double>> GetCentroid(
+    size_t count,
+    ValuePoints::const_iterator first,
+    ValuePoints::const_iterator last);
 
 
+/*
+ * Groups points by their distance to the first point of each group.
+ *
+ * The first point of each group is hashed into a grid of radius-sized
+ * cells, so a point is only compared to the groups of the nine cells about
+ * it. A point joins the first group in the order of their first points
+ * that is within radius, and vertices are listed in that order.
+ */
 class PointGroups
 {
 public:
-    PointGroups(double radius, size_t count)
-        :
-        radiusSquared_(radius * radius),
-        count_(count),
-        pointGroupByPoint_()
-    {
+    PointGroups(double radius, size_t count);
 
+    template<typename T>
+    void AddMatrix(size_t threads, const tau::MonoImage<T> &input)
+    {
+        // The non-zero values are listed in parallel, in row-major order.
+        this->AddMaxima(ListNonZero(threads, input));
     }
 
+    // Adds points that have already been listed in row-major order, like
+    // the non-zero values AddMatrix would find.
     template<typename T>
-    void AddMatrix(const tau::MonoImage<T> &input)
+    void AddMaxima(const LocalMaxima<T> &maxima)
     {
-        // Create a vector of all of the non-zero values.
-        ValuePoints points;
-        points.reserve(static_cast<size_t>((input.array() > 0).count()));
-
-        using Index = Eigen::Index;
+        auto pointCount = this->points_.size() + maxima.size();
+        this->points_.reserve(pointCount);
+        this->groupIndices_.reserve(pointCount);
 
-        for (Index row = 0; row < input.rows(); ++row)
+        for (auto &maximum: maxima)
         {
-            for (Index column = 0; column < input.cols(); ++column)
-            {
-                T value = input(row, column);
-
-                if (value != 0)
-                {
-                    points.emplace_back(
-                        static_cast<double>(column),
-                        static_cast<double>(row),
-                        static_cast<double>(value));
-                }
-            }
+            this->AddPoint_(
+                draw::ValuePoint<double>(
+                    static_cast<double>(maximum.column),
+                    static_cast<double>(maximum.row),
+                    static_cast<double>(maximum.value)));
         }
 
-        for (auto &point: points)
-        {
-            this->AddPoint_(point);
-        }
-
-        for (auto & [key, group]: this->pointGroupByPoint_)
-        {
-            if (group.size() > 4)
-            {
-                // Retain the top 4 values.
-                std::sort(
-                    group.begin(),
-                    group.end(),
-                    [](const auto &first, const auto &second)
-                    {
-                        return first.value > second.value;
-                    });
-
-                group.resize(4);
-            }
-
-            assert(!group.empty());
-            auto it = std::begin(group);
-            double maximumValue = it->value;
-
-            while (it != std::end(group))
-            {
-                maximumValue = std::max(maximumValue, (it++)->value);
-            }
-
-            for (auto &point: group)
-            {
-                point.value /= maximumValue;
-            }
-        }
+        this->NormalizeGroups_();
     }
 
-    Vertices GetVertices() const;
+    VertexSet GetVertices() const;
 
 private:
+    using Cell = std::pair<int64_t, int64_t>;
+
+    struct CellHash
+    {
+        size_t operator()(const Cell &cell) const;
+    };
+
+    Cell GetCell_(const tau::Point2d<double> &point) const;
+
     void AddPoint_(const draw::ValuePoint<double> &point);
 
+    // Retains the top 4 values of each group, scaled by the group maximum.
+    void NormalizeGroups_();
+
     double radiusSquared_;
+    double cellSize_;
     size_t count_;
 
-    std::map<tau::Point2d<double>, ValuePoints> pointGroupByPoint_;
+    // The first point of each group.
+    std::vector<tau::Point2d<double>> seeds_;
+
+    // The groups with a first point in each cell.
+    std::unordered_map<Cell, std::vector<size_t>, CellHash> groupsByCell_;
+
+    // Every point added, and the index of its group.
+    ValuePoints points_;
+    std::vector<size_t> groupIndices_;
+
+    // The normalized points of group g are
+    // groupPoints_[groupOffsets_[g]] to groupPoints_[groupOffsets_[g + 1] - 1],
+    // and groupOrder_ lists the groups by their first points.
+    ValuePoints groupPoints_;
+    std::vector<size_t> groupOffsets_;
+    std::vector<size_t> groupOrder_;
 };
 
 
@@ -147,7 +181,7 @@ private:
 class VertexFinder
 {
 public:
-    using Result = Vertices;
+    using Result = VertexSet;
 
     VertexFinder() = default;
 
@@ -164,7 +198,8 @@ public:
         assert(settings.count > 0);
     }
 
-    bool Filter(const tau::MonoImage<double> &input, Result &result)
+    template<typename Float>
+    bool Filter(const HarrisResult<Float> &input, Result &result)
     {
         if (!this->isEnabled_)
         {
@@ -175,8 +210,8 @@ public:
             this->windowSize_ / 2,
             this->count_);
 
-        pointGroups.AddMatrix(input);
-        result = Result(pointGroups.GetVertices());
+        pointGroups.AddMaxima(input.maxima);
+        result = pointGroups.GetVertices();
 
         return true;
     }
@@ -5,7 +5,8 @@ namespace iris
 {
 
 
-VertexChainResults::VertexChainResults(int64_t shapesId)
+template<typename Float>
+VertexChainResults<Float>::VertexChainResults(int64_t shapesId)
     :
     gaussian{},
     gradient{},
@@ -17,7 +18,8 @@ VertexChainResults::VertexChainResults(int64_t shapesId)
 }
 
 
-std::shared_ptr<draw::Pixels> VertexChainResults::Display(
+template<typename Float>
+std::shared_ptr<draw::Pixels> VertexChainResults<Float>::Display(
     const tau::Margins &margins,
     draw::AsyncShapesControl shapesControl,
     const draw::PointsShapeSettings &pointsShapeSettings,
@@ -38,7 +40,7 @@ std::shared_ptr<draw::Pixels> VertexChainResults::Display(
 
         shapes.EmplaceBack<draw::PointsShape>(
             pointsShapeSettings,
-            VerticesToPoints(*this->vertex));
+            this->vertex->GetPoints());
 
         shapesControl.Set(shapes);
 
@@ -61,7 +63,11 @@ std::shared_ptr<draw::Pixels> VertexChainResults::Display(
 }
 
 
-template class VertexChain<DefaultLevelAdjustNode>;
+template struct VertexChainResults<float>;
+template struct VertexChainResults<double>;
+
+template class VertexChain<float, DefaultLevelAdjustNode>;
+template class VertexChain<double, DefaultLevelAdjustNode>;
 
 
 } // end namespace iris
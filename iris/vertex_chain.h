@@ -23,11 +23,12 @@ using FilterResult =
     std::shared_ptr<const typename Filter::Result>;
 
 
+template<typename Float>
 struct VertexChainFilters
 {
     using GaussianFilter = Gaussian<int32_t, 0>;
     using GradientFilter = Gradient<int32_t>;
-    using HarrisFilter = Harris<double>;
+    using HarrisFilter = Harris<Float>;
     using VertexFilter = VertexFinder;
 
     using GaussianResult = FilterResult<GaussianFilter>;
@@ -38,9 +39,10 @@ struct VertexChainFilters
 
 
 
+template<typename Float>
 struct VertexChainResults
 {
-    using Filters = VertexChainFilters;
+    using Filters = VertexChainFilters<Float>;
 
     typename Filters::GaussianResult gaussian;
     typename Filters::GradientResult gradient;
@@ -60,10 +62,10 @@ private:
 };
 
 
-template<typename SourceNode>
+template<typename Float, typename SourceNode>
 struct VertexChainNodes
 {
-    using Filters = VertexChainFilters;
+    using Filters = VertexChainFilters<Float>;
     using GaussianFilter = typename Filters::GaussianFilter;
     using GradientFilter = typename Filters::GradientFilter;
     using HarrisFilter = typename Filters::HarrisFilter;
@@ -71,7 +73,7 @@ struct VertexChainNodes
 
     using Result = typename VertexFilter::Result;
     using ResultPtr = std::shared_ptr<const Result>;
-    using ChainResults = VertexChainResults;
+    using ChainResults = VertexChainResults<Float>;
 
     using GaussianNode =
         iris::Node<SourceNode, GaussianFilter, GaussianControl<int32_t>>;
@@ -79,7 +81,7 @@ struct VertexChainNodes
     using GradientNode_ = GradientNode<GaussianNode>;
 
     using HarrisNode =
-        iris::Node<GradientNode_, HarrisFilter, HarrisControl<double>>;
+        iris::Node<GradientNode_, HarrisFilter, HarrisControl<Float>>;
 
     using VertexNode =
         iris::Node<HarrisNode, VertexFilter, VertexControl>;
@@ -92,7 +94,7 @@ struct VertexChainNodes
 
     VertexChainNodes(
         SourceNode &source_,
-        VertexChainControl controls,
+        VertexChainControl<Float> controls,
         CancelControl cancel)
         :
         source(source_),
@@ -107,15 +109,15 @@ struct VertexChainNodes
 };
 
 
-template<typename SourceNode>
+template<typename Float, typename SourceNode>
 class VertexChain
     :
     public NodeBase
         <
             SourceNode,
-            VertexChainControl,
-            typename VertexChainNodes<SourceNode>::Result,
-            VertexChain<SourceNode>
+            VertexChainControl<Float>,
+            typename VertexChainNodes<Float, SourceNode>::Result,
+            VertexChain<Float, SourceNode>
         >
 {
 public:
@@ -123,18 +125,18 @@ public:
     using Base = NodeBase
         <
             SourceNode,
-            VertexChainControl,
-            typename VertexChainNodes<SourceNode>::Result,
-            VertexChain<SourceNode>
+            VertexChainControl<Float>,
+            typename VertexChainNodes<Float, SourceNode>::Result,
+            VertexChain<Float, SourceNode>
         >;
 
     using Result = typename Base::Result;
     using ResultPtr = typename Base::ResultPtr;
-    using ChainResults = VertexChainResults;
+    using ChainResults = VertexChainResults<Float>;
 
     VertexChain(
         SourceNode &sourceNode,
-        VertexChainControl controls,
+        VertexChainControl<Float> controls,
         CancelControl cancel)
         :
         Base("VertexChain", sourceNode, controls, cancel),
@@ -194,12 +196,18 @@ public:
 
 private:
     draw::ShapesId shapesId_;
-    VertexChainNodes<SourceNode> nodes_;
+    VertexChainNodes<Float, SourceNode> nodes_;
 };
 
 
-extern template class VertexChain<DefaultLevelAdjustNode>;
-using DefaultVertexChain = VertexChain<DefaultLevelAdjustNode>;
+extern template struct VertexChainResults<float>;
+extern template struct VertexChainResults<double>;
+
+extern template class VertexChain<float, DefaultLevelAdjustNode>;
+extern template class VertexChain<double, DefaultLevelAdjustNode>;
+
+template<typename Float>
+using DefaultVertexChain = VertexChain<Float, DefaultLevelAdjustNode>;
 
 
 } // end namespace iris
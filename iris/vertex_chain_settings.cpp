@@ -4,6 +4,14 @@
 template struct pex::Group
     <
         iris::VertexChainFields,
-        iris::VertexChainTemplate,
-        iris::VertexChainCustom
+        iris::VertexChainTemplate<float>::template Template,
+        iris::VertexChainCustom<float>
+    >;
+
+
+template struct pex::Group
+    <
+        iris::VertexChainFields,
+        iris::VertexChainTemplate<double>::template Template,
+        iris::VertexChainCustom<double>
     >;
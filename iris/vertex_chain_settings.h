@@ -63,23 +63,26 @@ struct VertexChainFields
 };
 
 
-template<template<typename> typename T>
+template<typename Float>
 struct VertexChainTemplate
 {
-    T<bool> enable;
-    T<GaussianGroup<int32_t>> gaussian;
-    T<GradientGroup<int32_t>> gradient;
-    T<HarrisGroup<double>> harris;
-    T<VertexGroup> vertex;
-    T<draw::PointsShapeGroup> shape;
-
-    static constexpr auto fields =
-        VertexChainFields<VertexChainTemplate>::fields;
-
-    static constexpr auto fieldsTypeName = "VertexChain";
+    template<template<typename> typename T>
+    struct Template
+    {
+        T<bool> enable;
+        T<GaussianGroup<int32_t>> gaussian;
+        T<GradientGroup<int32_t>> gradient;
+        T<HarrisGroup<Float>> harris;
+        T<VertexGroup> vertex;
+        T<draw::PointsShapeGroup> shape;
+
+        static constexpr auto fields = VertexChainFields<Template>::fields;
+        static constexpr auto fieldsTypeName = "VertexChain";
+    };
 };
 
 
+template<typename Float>
 struct VertexChainCustom
 {
     template<typename Base>
@@ -91,7 +94,7 @@ struct VertexChainCustom
                 true,
                 GaussianSettings<int32_t>{},
                 GradientSettings<int32_t>{},
-                HarrisSettings<double>{},
+                HarrisSettings<Float>{},
                 VertexSettings{},
                 draw::PointsShapeSettings{}}
         {
@@ -132,20 +135,29 @@ struct VertexChainCustom
 };
 
 
+template<typename Float>
 using VertexChainGroup = pex::Group
     <
         VertexChainFields,
-        VertexChainTemplate,
-        VertexChainCustom
+        VertexChainTemplate<Float>::template Template,
+        VertexChainCustom<Float>
     >;
 
 
-using VertexChainSettings = typename VertexChainGroup::Plain;
-using VertexChainModel = typename VertexChainGroup::Model;
-using VertexChainControl = typename VertexChainGroup::DefaultControl;
+template<typename Float>
+using VertexChainSettings = typename VertexChainGroup<Float>::Plain;
+
+template<typename Float>
+using VertexChainModel = typename VertexChainGroup<Float>::Model;
+
+template<typename Float>
+using VertexChainControl = typename VertexChainGroup<Float>::DefaultControl;
 
-DECLARE_EQUALITY_OPERATORS(VertexChainSettings)
-DECLARE_OUTPUT_STREAM_OPERATOR(VertexChainSettings)
+DECLARE_EQUALITY_OPERATORS(VertexChainSettings<float>)
+DECLARE_OUTPUT_STREAM_OPERATOR(VertexChainSettings<float>)
+
+DECLARE_EQUALITY_OPERATORS(VertexChainSettings<double>)
+DECLARE_OUTPUT_STREAM_OPERATOR(VertexChainSettings<double>)
 
 
 } // end namespace iris
@@ -154,6 +166,14 @@ DECLARE_OUTPUT_STREAM_OPERATOR(VertexChainSettings)
 extern template struct pex::Group
     <
         iris::VertexChainFields,
-        iris::VertexChainTemplate,
-        iris::VertexChainCustom
+        iris::VertexChainTemplate<float>::template Template,
+        iris::VertexChainCustom<float>
+    >;
+
+
+extern template struct pex::Group
+    <
+        iris::VertexChainFields,
+        iris::VertexChainTemplate<double>::template Template,
+        iris::VertexChainCustom<double>
     >;
@@ -14,9 +14,10 @@ namespace iris
 {
 
 
-CannyChainSettingsView::CannyChainSettingsView(
+template<typename Float>
+CannyChainSettingsView<Float>::CannyChainSettingsView(
     wxWindow *parent,
-    const CannyChainControl &controls,
+    const CannyChainControl<Float> &controls,
     const CannyChainNodeSettingsControl *nodeSettings,
     const LayoutOptions &layoutOptions)
     :
@@ -49,7 +50,7 @@ CannyChainSettingsView::CannyChainSettingsView(
             layoutOptions);
 
     auto canny =
-        new CannySettingsView<double>(
+        new CannySettingsView<Float>(
             panel,
             controls.canny,
             (nodeSettings)
@@ -68,4 +69,8 @@ CannyChainSettingsView::CannyChainSettingsView(
 }
 
 
+template class CannyChainSettingsView<float>;
+template class CannyChainSettingsView<double>;
+
+
 } // end namespace iris
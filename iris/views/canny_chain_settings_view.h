@@ -11,6 +11,7 @@ namespace iris
 {
 
 
+template<typename Float>
 class CannyChainSettingsView: public wxpex::Collapsible
 {
 public:
@@ -18,10 +19,14 @@ public:
 
     CannyChainSettingsView(
         wxWindow *parent,
-        const CannyChainControl &controls,
+        const CannyChainControl<Float> &controls,
         const CannyChainNodeSettingsControl *nodeSettings = nullptr,
         const LayoutOptions &layoutOptions = LayoutOptions{});
 };
 
 
+extern template class CannyChainSettingsView<float>;
+extern template class CannyChainSettingsView<double>;
+
+
 } // end namespace iris
@@ -5,6 +5,7 @@ namespace iris
 {
 
 
+template class CannySettingsView<float>;
 template class CannySettingsView<double>;
 
 
@@ -56,10 +56,10 @@ public:
                 controls.range.low,
                 controls.range.low.value));
 
-        auto depth = wxpex::LabeledWidget(
+        auto edgeList = wxpex::LabeledWidget(
             panel,
-            "Depth",
-            new wxpex::Field(panel, controls.depth));
+            "Edge list",
+            new wxpex::CheckBox(panel, "", controls.edgeList));
 
         auto threads = wxpex::LabeledWidget(
             panel,
@@ -71,14 +71,15 @@ public:
             enable,
             high,
             low,
-            threads,
-            depth);
+            edgeList,
+            threads);
 
         this->ConfigureSizer(std::move(sizer));
     }
 };
 
 
+extern template class CannySettingsView<float>;
 extern template class CannySettingsView<double>;
 
 
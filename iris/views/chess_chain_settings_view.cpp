@@ -3,6 +3,7 @@
 #include <wxpex/labeled_widget.h>
 #include <wxpex/layout_items.h>
 #include <wxpex/check_box.h>
+#include <wxpex/slider.h>
 #include <wxpex/button.h>
 #include <wxpex/indent_sizer.h>
 #include <draw/node_settings.h>
@@ -16,7 +17,9 @@
 #include "iris/views/hough_settings_view.h"
 #include "iris/views/harris_settings_view.h"
 #include "iris/views/vertex_settings_view.h"
+#include "iris/views/saddle_settings_view.h"
 #include "iris/views/chess_settings_view.h"
+#include "iris/views/chess_tracker_settings_view.h"
 #include "iris/views/defaults.h"
 
 
@@ -24,9 +27,10 @@ namespace iris
 {
 
 
-ChessChainSettingsView::ChessChainSettingsView(
+template<typename Float>
+ChessChainSettingsView<Float>::ChessChainSettingsView(
     wxWindow *parent,
-    const ChessChainControl &control,
+    const ChessChainControl<Float> &control,
     const ChessChainNodeSettingsControl *nodeSettings,
     const LayoutOptions &layoutOptions)
     :
@@ -72,7 +76,7 @@ ChessChainSettingsView::ChessChainSettingsView(
             layoutOptions);
 
     auto canny =
-        new CannySettingsView<double>(
+        new CannySettingsView<Float>(
             panel,
             control.canny,
             (nodeSettings) ? &nodeSettings->canny : nullptr,
@@ -80,7 +84,7 @@ ChessChainSettingsView::ChessChainSettingsView(
 
     // Line detection
     auto hough =
-        new HoughSettingsView<double>(
+        new HoughSettingsView<Float>(
             panel,
             control.hough,
             (nodeSettings) ? &nodeSettings->hough : nullptr,
@@ -102,6 +106,24 @@ ChessChainSettingsView::ChessChainSettingsView(
                 : nullptr,
             layoutOptions);
 
+    auto sparseHarris = LabeledWidget(
+        panel,
+        "sparse harris",
+        new CheckBox(panel, "", control.sparseHarris));
+
+    auto candidateWindow = LabeledWidget(
+        panel,
+        "candidate window",
+        new ValueSlider(
+            panel,
+            control.candidateWindow,
+            control.candidateWindow.value));
+
+    auto candidates = LayoutLabeled(
+        layoutOptions,
+        sparseHarris,
+        candidateWindow);
+
     auto verticesSettings =
         new VertexSettingsView(
             panel,
@@ -111,6 +133,18 @@ ChessChainSettingsView::ChessChainSettingsView(
                 : nullptr,
             layoutOptions);
 
+    auto saddle =
+        new SaddleSettingsView(
+            panel,
+            control.saddle,
+            (nodeSettings)
+                ? &nodeSettings->saddle
+                : nullptr,
+            layoutOptions);
+
+    auto useSaddle =
+        new wxpex::CheckBox(panel, "use saddle", control.useSaddle);
+
     auto verticesShape =
         new draw::PointsShapeView(
             panel,
@@ -127,6 +161,12 @@ ChessChainSettingsView::ChessChainSettingsView(
                 : nullptr,
             layoutOptions);
 
+    auto tracker =
+        new ChessTrackerSettingsView(
+            panel,
+            control.tracker,
+            layoutOptions);
+
     auto autoDetect =
         new wxpex::Button(panel, "Auto", control.autoDetectSettings);
 
@@ -141,13 +181,21 @@ ChessChainSettingsView::ChessChainSettingsView(
         hough,
         linesShape,
         harris,
+        std::move(candidates),
         verticesSettings,
+        saddle,
+        useSaddle,
         verticesShape,
-        chess);
+        chess,
+        tracker);
 
     sizer->Add(autoDetect, 0, wxALIGN_CENTER | wxTOP, 5);
     this->ConfigureSizer(std::move(sizer));
 }
 
 
+template class ChessChainSettingsView<float>;
+template class ChessChainSettingsView<double>;
+
+
 } // end namespace iris
@@ -12,6 +12,7 @@ namespace iris
 {
 
 
+template<typename Float>
 class ChessChainSettingsView: public wxpex::Collapsible
 {
 public:
@@ -19,10 +20,14 @@ public:
 
     ChessChainSettingsView(
         wxWindow *parent,
-        const ChessChainControl &control,
+        const ChessChainControl<Float> &control,
         const ChessChainNodeSettingsControl *nodeSettingsControl = nullptr,
         const LayoutOptions &layoutOptions = LayoutOptions{});
 };
 
 
+extern template class ChessChainSettingsView<float>;
+extern template class ChessChainSettingsView<double>;
+
+
 } // end namespace iris
@@ -0,0 +1,71 @@
+#include "chess_tracker_settings_view.h"
+
+#include <wxpex/labeled_widget.h>
+#include <wxpex/slider.h>
+#include <wxpex/field.h>
+#include <wxpex/check_box.h>
+#include "iris/views/defaults.h"
+
+
+namespace iris
+{
+
+
+ChessTrackerSettingsView::ChessTrackerSettingsView(
+    wxWindow *parent,
+    const ChessTrackerControl &controls,
+    const LayoutOptions &layoutOptions)
+    :
+    wxpex::Collapsible(parent, "Chess Tracker", borderStyle)
+{
+    using namespace wxpex;
+
+    auto panel = this->GetPanel();
+
+    auto enable = LabeledWidget(
+        panel,
+        "enable",
+        new CheckBox(panel, "", controls.enable));
+
+    auto window = LabeledWidget(
+        panel,
+        "window",
+        new ValueSlider(
+            panel,
+            controls.window,
+            controls.window.value));
+
+    auto maximumError = LabeledWidget(
+        panel,
+        "maximum error",
+        new ValueSlider(
+            panel,
+            controls.maximumError,
+            controls.maximumError.value));
+
+    auto minimumFraction = LabeledWidget(
+        panel,
+        "minimum fraction",
+        new ValueSlider(
+            panel,
+            controls.minimumFraction,
+            controls.minimumFraction.value));
+
+    auto keyframeInterval = LabeledWidget(
+        panel,
+        "keyframe interval",
+        new Field(panel, controls.keyframeInterval));
+
+    auto sizer = LayoutLabeled(
+        layoutOptions,
+        enable,
+        window,
+        maximumError,
+        minimumFraction,
+        keyframeInterval);
+
+    this->ConfigureSizer(std::move(sizer));
+}
+
+
+} // end namespace iris
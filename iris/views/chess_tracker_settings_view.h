@@ -0,0 +1,25 @@
+#pragma once
+
+
+#include <wxpex/labeled_widget.h>
+#include <wxpex/collapsible.h>
+#include "iris/chess_tracker_settings.h"
+
+
+namespace iris
+{
+
+
+class ChessTrackerSettingsView: public wxpex::Collapsible
+{
+public:
+    using LayoutOptions = wxpex::LayoutOptions;
+
+    ChessTrackerSettingsView(
+        wxWindow *parent,
+        const ChessTrackerControl &controls,
+        const LayoutOptions &layoutOptions = LayoutOptions{});
+};
+
+
+} // end namespace iris
@@ -42,10 +42,19 @@ public:
                 control.detectMargin,
                 control.detectMargin.value));
 
+        auto detectStride = wxpex::LabeledWidget(
+            this->GetPanel(),
+            "Detect Stride",
+            new wxpex::ValueSlider(
+                this->GetPanel(),
+                control.detectStride,
+                control.detectStride.value));
+
         auto sizer = wxpex::LayoutItems(
             wxpex::verticalItems,
             detect,
-            detectMargin.Layout());
+            detectMargin.Layout(),
+            detectStride.Layout());
 
         this->ConfigureSizer(std::move(sizer));
     }
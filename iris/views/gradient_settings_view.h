@@ -73,6 +73,14 @@ public:
             "Percentile",
             new wxpex::Field(this->GetPanel(), controls.percentile));
 
+        auto detectStride = wxpex::LabeledWidget(
+            this->GetPanel(),
+            "Detect Stride",
+            new ValueSlider(
+                this->GetPanel(),
+                controls.detectStride,
+                controls.detectStride.value));
+
         auto detect = new wxpex::Button(
             this->GetPanel(),
             "Detect",
@@ -85,7 +93,8 @@ public:
             size,
             maximum,
             threads,
-            percentile);
+            percentile,
+            detectStride);
 
         auto topSizer = std::make_unique<wxBoxSizer>(wxVERTICAL);
         topSizer->Add(sizer.release(), 0, wxEXPAND | wxBOTTOM, 3);
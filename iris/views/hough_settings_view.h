@@ -52,6 +52,11 @@ public:
             "theta count",
             new wxpex::Field(panel, controls.thetaCount));
 
+        auto coarseFactor = wxpex::LabeledWidget(
+            panel,
+            "Coarse factor",
+            new wxpex::Field(panel, controls.coarseFactor));
+
         auto angleRange = LabeledWidget(
             panel,
             "Angle range",
@@ -60,11 +65,26 @@ public:
                 controls.angleRange,
                 controls.angleRange.value));
 
+        auto orientationModes = wxpex::LabeledWidget(
+            panel,
+            "Orientation modes",
+            new wxpex::Field(panel, controls.orientationModes));
+
+        auto modeWidth = wxpex::LabeledWidget(
+            panel,
+            "Mode width",
+            new wxpex::Field(panel, controls.modeWidth));
+
         auto weighted = wxpex::LabeledWidget(
             panel,
             "Weighted",
             new wxpex::CheckBox(panel, "", controls.weighted));
 
+        auto weightScale = wxpex::LabeledWidget(
+            panel,
+            "Weight scale",
+            new wxpex::Field(panel, controls.weightScale));
+
         auto suppress = wxpex::LabeledWidget(
             panel,
             "Suppress",
@@ -86,6 +106,11 @@ public:
                 controls.threshold,
                 controls.threshold.value));
 
+        auto maximumLines = wxpex::LabeledWidget(
+            panel,
+            "Maximum lines",
+            new wxpex::Field(panel, controls.maximumLines));
+
         auto includeEdges = wxpex::LabeledWidget(
             panel,
             "Include edges",
@@ -96,6 +121,16 @@ public:
             "Edge tolerance",
             new wxpex::Field(panel, controls.edgeTolerance));
 
+        auto streaming = wxpex::LabeledWidget(
+            panel,
+            "Streaming",
+            new wxpex::CheckBox(panel, "", controls.streaming));
+
+        auto streamingLimit = wxpex::LabeledWidget(
+            panel,
+            "Streaming limit",
+            new wxpex::Field(panel, controls.streamingLimit));
+
         auto threads = wxpex::LabeledWidget(
             panel,
             "Threads",
@@ -106,13 +141,20 @@ public:
             enable,
             rhoCount,
             thetaCount,
+            coarseFactor,
             angleRange,
+            orientationModes,
+            modeWidth,
             weighted,
+            weightScale,
             suppress,
             window,
             threshold,
+            maximumLines,
             includeEdges,
             edgeTolerance,
+            streaming,
+            streamingLimit,
             threads);
 
         this->ConfigureSizer(std::move(sizer));
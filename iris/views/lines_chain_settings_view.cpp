@@ -14,9 +14,10 @@ namespace iris
 {
 
 
-LinesChainSettingsView::LinesChainSettingsView(
+template<typename Float>
+LinesChainSettingsView<Float>::LinesChainSettingsView(
     wxWindow *parent,
-    const LinesChainControl &controls,
+    const LinesChainControl<Float> &controls,
     const LinesChainNodeSettingsControl *nodeSettings,
     const LayoutOptions &layoutOptions)
     :
@@ -29,14 +30,14 @@ LinesChainSettingsView::LinesChainSettingsView(
     auto enable =
         new wxpex::CheckBox(panel, "enable", controls.enable);
 
-    auto cannyChain = new CannyChainSettingsView(
+    auto cannyChain = new CannyChainSettingsView<Float>(
         panel,
         controls.cannyChain,
         (nodeSettings) ? &nodeSettings->cannyChain : nullptr,
         layoutOptions);
 
     auto hough =
-        new HoughSettingsView<double>(
+        new HoughSettingsView<Float>(
             panel,
             controls.hough,
             (nodeSettings) ? &nodeSettings->hough : nullptr,
@@ -59,4 +60,8 @@ LinesChainSettingsView::LinesChainSettingsView(
 }
 
 
+template class LinesChainSettingsView<float>;
+template class LinesChainSettingsView<double>;
+
+
 } // end namespace iris
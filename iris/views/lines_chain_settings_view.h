@@ -11,6 +11,7 @@ namespace iris
 {
 
 
+template<typename Float>
 class LinesChainSettingsView: public wxpex::Collapsible
 {
 public:
@@ -18,10 +19,14 @@ public:
 
     LinesChainSettingsView(
         wxWindow *parent,
-        const LinesChainControl &controls,
+        const LinesChainControl<Float> &controls,
         const LinesChainNodeSettingsControl *nodeSettingsControl = nullptr,
         const LayoutOptions &layoutOptions = LayoutOptions{});
 };
 
 
+extern template class LinesChainSettingsView<float>;
+extern template class LinesChainSettingsView<double>;
+
+
 } // end namespace iris
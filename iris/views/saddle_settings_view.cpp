@@ -0,0 +1,74 @@
+#include "iris/views/saddle_settings_view.h"
+
+#include <wxpex/labeled_widget.h>
+#include <wxpex/slider.h>
+#include <wxpex/field.h>
+#include <wxpex/check_box.h>
+#include <wxpex/view.h>
+
+#include "iris/views/defaults.h"
+
+
+namespace iris
+{
+
+
+SaddleSettingsView::SaddleSettingsView(
+    wxWindow *parent,
+    const SaddleControl &controls,
+    const draw::NodeSettingsControl *nodeSettingsControl,
+    const LayoutOptions &layoutOptions)
+    :
+    draw::CollapsibleNodeSettingsView(parent, "Saddle", nodeSettingsControl)
+{
+    using namespace wxpex;
+
+    auto panel = this->GetPanel();
+
+    auto enable = LabeledWidget(
+        panel,
+        "enable",
+        new CheckBox(panel, "", controls.enable));
+
+    auto sigma = LabeledWidget(
+        panel,
+        "sigma",
+        new ValueSlider(
+            panel,
+            controls.sigma,
+            controls.sigma.value));
+
+    auto threshold = LabeledWidget(
+        panel,
+        "threshold",
+        new ValueSlider(
+            panel,
+            controls.threshold,
+            controls.threshold.value));
+
+    auto window = LabeledWidget(
+        panel,
+        "window",
+        new ValueSlider(
+            panel,
+            controls.window,
+            controls.window.value));
+
+    auto threads = LabeledWidget(
+        panel,
+        "threads",
+        new Field(panel, controls.threads));
+
+    auto sizer = LayoutLabeled(
+        layoutOptions,
+        enable,
+        sigma,
+        threshold,
+        window,
+        threads);
+
+    this->ConfigureSizer(std::move(sizer));
+}
+
+
+} // end namespace iris
@@ -0,0 +1,28 @@
+#pragma once
+
+
+#include <wxpex/labeled_widget.h>
+#include <wxpex/collapsible.h>
+
+#include <draw/views/node_settings_view.h>
+#include "iris/saddle_settings.h"
+
+
+namespace iris
+{
+
+
+class SaddleSettingsView: public draw::CollapsibleNodeSettingsView
+{
+public:
+    using LayoutOptions = wxpex::LayoutOptions;
+
+    SaddleSettingsView(
+        wxWindow *parent,
+        const SaddleControl &controls,
+        const draw::NodeSettingsControl *nodeSettingsControl = nullptr,
+        const LayoutOptions &layoutOptions = LayoutOptions{});
+};
+
+
+} // end namespace iris
@@ -16,9 +16,10 @@ namespace iris
 {
 
 
-VertexChainSettingsView::VertexChainSettingsView(
+template<typename Float>
+VertexChainSettingsView<Float>::VertexChainSettingsView(
     wxWindow *parent,
-    const VertexChainControl &controls,
+    const VertexChainControl<Float> &controls,
     const VertexChainNodeSettingsControl *nodeSettings,
     const LayoutOptions &layoutOptions)
     :
@@ -88,4 +89,8 @@ VertexChainSettingsView::VertexChainSettingsView(
 }
 
 
+template class VertexChainSettingsView<float>;
+template class VertexChainSettingsView<double>;
+
+
 } // end namespace iris
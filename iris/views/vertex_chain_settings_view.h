@@ -10,6 +10,7 @@ namespace iris
 {
 
 
+template<typename Float>
 class VertexChainSettingsView: public wxpex::Collapsible
 {
 public:
@@ -17,10 +18,14 @@ public:
 
     VertexChainSettingsView(
         wxWindow *parent,
-        const VertexChainControl &controls,
+        const VertexChainControl<Float> &controls,
         const VertexChainNodeSettingsControl *nodeSettingsControl = nullptr,
         const LayoutOptions &layoutOptions = LayoutOptions{});
 };
 
 
+extern template class VertexChainSettingsView<float>;
+extern template class VertexChainSettingsView<double>;
+
+
 } // end namespace iris
@@ -0,0 +1,186 @@
+#include <catch2/catch.hpp>
+
+#include <iris/canny.h>
+
+#include "chessboard.h"
+
+
+using chessboard::MakeChessboard;
+using chessboard::GetGradient;
+
+
+// A chessboard with a bright disk over one corner, so that edges cross
+// the rows of every thread at several orientations.
+chessboard::Image MakeEdgeImage()
+{
+    using Eigen::Index;
+
+    auto result = MakeChessboard(6, 32);
+    Index center = result.rows() / 3;
+    Index radius = result.rows() / 5;
+
+    for (Index row = 0; row < result.rows(); ++row)
+    {
+        for (Index column = 0; column < result.cols(); ++column)
+        {
+            Index y = row - center;
+            Index x = column - center;
+
+            if (x * x + y * y < radius * radius)
+            {
+                result(row, column) =
+                    std::min(255.0f, result(row, column) + 60.0f);
+            }
+        }
+    }
+
+    return result;
+}
+
+
+iris::CannyResult<double> FilterCanny(size_t threads, bool edgeList)
+{
+    iris::CannySettings<double> settings;
+    settings.threads = threads;
+    settings.edgeList = edgeList;
+
+    iris::CannyResult<double> result;
+
+    REQUIRE(
+        iris::Canny<double>(settings).Filter(
+            GetGradient(MakeEdgeImage()),
+            result));
+
+    return result;
+}
+
+
+using ListedEdges = std::vector<std::tuple<uint16_t, uint16_t, float, float>>;
+
+
+// The edge list, in list order.
+ListedEdges GetListed(const iris::CannyEdges &edges)
+{
+    ListedEdges result;
+
+    for (size_t i = 0; i < edges.size(); ++i)
+    {
+        result.emplace_back(
+            edges.rows[i],
+            edges.columns[i],
+            edges.weights[i],
+            edges.phases[i]);
+    }
+
+    return result;
+}
+
+
+// The edge list, ordered by row, then column.
+ListedEdges GetSorted(const iris::CannyEdges &edges)
+{
+    auto result = GetListed(edges);
+    std::sort(std::begin(result), std::end(result));
+
+    return result;
+}
+
+
+TEST_CASE("Hysteresis does not depend on the thread count", "[canny]")
+{
+    auto single = FilterCanny(1, true);
+    REQUIRE((single.edges.array() != 0).count() > 0);
+
+    for (size_t threads: {2, 3, 8})
+    {
+        auto multiple = FilterCanny(threads, true);
+
+        REQUIRE(multiple.edges == single.edges);
+        REQUIRE(multiple.magnitude == single.magnitude);
+        REQUIRE(multiple.phase == single.phase);
+        REQUIRE(GetSorted(*multiple.edgeList) == GetSorted(*single.edgeList));
+    }
+}
+
+
+// The direction from the phase in degrees, as Canny computed it before the
+// gradient was quantized directly.
+int GetPhaseDirection(double dx, double dy)
+{
+    auto phase = tau::ToDegrees(std::atan2(dy, dx));
+
+    if (phase < 0)
+    {
+        phase += 360;
+    }
+
+    return static_cast<int>(std::round(phase / 45.0)) % 4;
+}
+
+
+TEST_CASE("Directions match the quantized phase", "[canny]")
+{
+    for (int dy = -255; dy <= 255; ++dy)
+    {
+        for (int dx = -255; dx <= 255; ++dx)
+        {
+            auto expected = GetPhaseDirection(dx, dy);
+
+            REQUIRE(
+                iris::Canny<double>::QuantizeDirection(
+                    static_cast<int16_t>(dx),
+                    static_cast<int16_t>(dy)) == expected);
+
+            REQUIRE(
+                iris::Canny<double>::QuantizeDirection(
+                    static_cast<float>(dx),
+                    static_cast<float>(dy)) == expected);
+        }
+    }
+}
+
+
+TEST_CASE("Canny planes only hold edge pixels", "[canny]")
+{
+    auto result = FilterCanny(4, false);
+    auto isEdge = (result.edges.array() != 0);
+
+    REQUIRE(isEdge.count() > 0);
+    REQUIRE((isEdge || result.magnitude.array() == 0.0f).all());
+    REQUIRE((isEdge || result.phase.array() == 0.0f).all());
+
+    auto low = static_cast<float>(result.rangeLow);
+
+    REQUIRE((!isEdge || result.magnitude.array() > low).all());
+    REQUIRE((result.magnitude.array() <= 1.0f).all());
+    REQUIRE((result.phase.array() >= 0.0f).all());
+    REQUIRE((result.phase.array() < 360.0f).all());
+}
+
+
+TEST_CASE("Canny edge list matches the edge map", "[canny]")
+{
+    auto withList = FilterCanny(4, true);
+    REQUIRE(withList.edgeList);
+    REQUIRE(!withList.edgeList->empty());
+
+    REQUIRE(
+        GetSorted(*withList.edgeList)
+        == GetSorted(withList.ScanEdgeList()));
+
+    // The list is in row-major order, whichever thread found each edge, so
+    // weighted votes are summed in the same order every time.
+    auto expected = GetListed(withList.ScanEdgeList());
+    REQUIRE(GetListed(*withList.edgeList) == expected);
+
+    for (size_t threads: {1, 2, 8})
+    {
+        auto listed = FilterCanny(threads, true);
+        REQUIRE(listed.edgeList);
+        REQUIRE(GetListed(*listed.edgeList) == expected);
+    }
+
+    auto withoutList = FilterCanny(4, false);
+    REQUIRE(!withoutList.edgeList);
+    REQUIRE(withoutList.edges == withList.edges);
+}
@@ -0,0 +1,102 @@
+#include <catch2/catch.hpp>
+
+#include <iris/chess_chain.h>
+
+#include "chessboard.h"
+
+
+static constexpr Eigen::Index squareCount = 6;
+static constexpr Eigen::Index squareSize = 32;
+
+
+iris::ProcessMatrix MakeSourceData(const tau::Point2d<Eigen::Index> &shift)
+{
+    return chessboard::MakeChessboard(squareCount, squareSize, shift)
+        .array().round().matrix().template cast<iris::InProcess>();
+}
+
+
+TEMPLATE_TEST_CASE("Tracked frames skip the detection nodes", "[chess_chain]",
+    float, double)
+{
+    using Chain = iris::ChessChain<TestType>;
+
+    auto imageSize = static_cast<int>((squareCount + 2) * squareSize);
+
+    iris::ChessChainModel<TestType> model;
+    model.mask.imageSize.Set(draw::Size{imageSize, imageSize});
+    model.hough.imageSize.Set(draw::Size{imageSize, imageSize});
+    model.tracker.enable.Set(true);
+    model.tracker.keyframeInterval.Set(0);
+
+    iris::Cancel cancel(false);
+    typename Chain::SourceNode source;
+
+    Chain chain(
+        source,
+        iris::ChessChainControl<TestType>(model),
+        iris::CancelControl(cancel));
+
+    chain.SetKeyframe(chessboard::MakeSolution(squareCount, squareSize));
+    source.SetData(MakeSourceData({3, 2}));
+
+    auto tracked = chain.GetChainResults();
+    REQUIRE(tracked);
+    REQUIRE(tracked->chess);
+    REQUIRE(tracked->gradient);
+    REQUIRE(tracked->isTracked);
+
+    REQUIRE(!tracked->canny);
+    REQUIRE(!tracked->hough);
+    REQUIRE(!tracked->harris);
+    REQUIRE(!tracked->vertices);
+
+    // Without tracking, the full chain runs again.
+    model.tracker.enable.Set(false);
+
+    auto detected = chain.GetChainResults();
+    REQUIRE(detected);
+    REQUIRE(!detected->isTracked);
+    REQUIRE(detected->canny);
+    REQUIRE(detected->hough);
+    REQUIRE(detected->harris);
+    REQUIRE(detected->vertices);
+}
+
+
+TEMPLATE_TEST_CASE("Saddles can supply the chess vertices", "[chess_chain]",
+    float, double)
+{
+    using Chain = iris::ChessChain<TestType>;
+
+    auto imageSize = static_cast<int>((squareCount + 2) * squareSize);
+
+    iris::ChessChainModel<TestType> model;
+    model.mask.imageSize.Set(draw::Size{imageSize, imageSize});
+    model.hough.imageSize.Set(draw::Size{imageSize, imageSize});
+    model.useSaddle.Set(true);
+
+    iris::Cancel cancel(false);
+    typename Chain::SourceNode source;
+
+    Chain chain(
+        source,
+        iris::ChessChainControl<TestType>(model),
+        iris::CancelControl(cancel));
+
+    source.SetData(MakeSourceData({0, 0}));
+
+    auto saddle = chain.GetChainResults();
+    REQUIRE(saddle);
+    REQUIRE(saddle->saddle);
+    REQUIRE(saddle->vertices == saddle->saddle);
+    REQUIRE(!saddle->harris);
+
+    model.useSaddle.Set(false);
+
+    auto harris = chain.GetChainResults();
+    REQUIRE(harris);
+    REQUIRE(harris->harris);
+    REQUIRE(harris->vertices);
+    REQUIRE(!harris->saddle);
+}
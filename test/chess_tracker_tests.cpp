@@ -0,0 +1,142 @@
+#include <catch2/catch.hpp>
+
+#include <iris/chess_tracker.h>
+
+#include "chessboard.h"
+
+
+using chessboard::MakeChessboard;
+using chessboard::GetGradient;
+
+
+static constexpr Eigen::Index squareCount = 6;
+static constexpr Eigen::Index squareSize = 32;
+
+
+iris::ChessSolution MakeSolution(const tau::Point2d<double> &shift)
+{
+    return chessboard::MakeSolution(squareCount, squareSize, shift);
+}
+
+
+iris::ChessTracker<double> MakeTracker(size_t keyframeInterval)
+{
+    iris::ChessTrackerSettings settings;
+    settings.enable = true;
+    settings.keyframeInterval = keyframeInterval;
+
+    return iris::ChessTracker<double>(
+        settings,
+        iris::HarrisSettings<double>{},
+        iris::VertexSettings{});
+}
+
+
+TEST_CASE("Grid homography maps logical vertices to pixels", "[tracker]")
+{
+    iris::GridHomography expected;
+
+    expected <<
+        31.0, 2.0, 100.0,
+        -3.0, 29.0, 80.0,
+        0.001, 0.002, 1.0;
+
+    iris::NamedVertices vertices;
+
+    for (size_t row = 0; row < 6; ++row)
+    {
+        for (size_t column = 0; column < 8; ++column)
+        {
+            iris::NamedVertex vertex{};
+            vertex.logical = tau::Point2d<size_t>(column, row);
+
+            vertex.pixel = iris::Project(
+                expected,
+                vertex.logical.template Cast<double>());
+
+            vertices.push_back(vertex);
+        }
+    }
+
+    auto homography = iris::FitGridHomography(vertices);
+    REQUIRE(homography);
+
+    for (auto &vertex: vertices)
+    {
+        auto pixel = iris::Project(
+            *homography,
+            vertex.logical.template Cast<double>());
+
+        REQUIRE(pixel.x == Approx(vertex.pixel.x));
+        REQUIRE(pixel.y == Approx(vertex.pixel.y));
+    }
+
+    vertices.resize(3);
+    REQUIRE(!iris::FitGridHomography(vertices));
+}
+
+
+TEST_CASE("Tracker follows a moving chessboard", "[tracker]")
+{
+    auto tracker = MakeTracker(0);
+    REQUIRE(tracker.NeedsKeyframe());
+
+    tracker.SetKeyframe(MakeSolution({0.0, 0.0}));
+    REQUIRE(!tracker.NeedsKeyframe());
+
+    // The second step is predicted by the motion of the first.
+    for (auto step: {1, 2})
+    {
+        tau::Point2d<Eigen::Index> shift(3 * step, 2 * step);
+
+        auto gradient = GetGradient(
+            MakeChessboard(squareCount, squareSize, shift));
+
+        iris::ChessSolution tracked;
+        REQUIRE(tracker.Track(gradient, tracked));
+
+        auto expected =
+            MakeSolution(shift.template Cast<double>()).vertices;
+
+        REQUIRE(tracked.vertices.size() == expected.size());
+
+        for (size_t index = 0; index < expected.size(); ++index)
+        {
+            auto &vertex = tracked.vertices[index];
+            REQUIRE(vertex.logical == expected[index].logical);
+
+            auto difference = vertex.pixel - expected[index].pixel;
+            REQUIRE(difference.SquaredSum() < 0.5 * 0.5);
+        }
+    }
+}
+
+
+TEST_CASE("Tracker requires a keyframe when the board is lost", "[tracker]")
+{
+    auto tracker = MakeTracker(0);
+    tracker.SetKeyframe(MakeSolution({0.0, 0.0}));
+
+    auto size = (squareCount + 2) * squareSize;
+
+    auto gradient = GetGradient(
+        chessboard::Image::Constant(size, size, 128.0f));
+
+    iris::ChessSolution tracked;
+    REQUIRE(!tracker.Track(gradient, tracked));
+    REQUIRE(tracker.NeedsKeyframe());
+}
+
+
+TEST_CASE("Tracker requires a keyframe after the interval", "[tracker]")
+{
+    auto tracker = MakeTracker(1);
+    tracker.SetKeyframe(MakeSolution({0.0, 0.0}));
+
+    auto gradient = GetGradient(MakeChessboard(squareCount, squareSize));
+
+    iris::ChessSolution tracked;
+    REQUIRE(tracker.Track(gradient, tracked));
+    REQUIRE(tracker.NeedsKeyframe());
+    REQUIRE(!tracker.Track(gradient, tracked));
+}
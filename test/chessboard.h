@@ -0,0 +1,110 @@
+#pragma once
+
+
+#include <catch2/catch.hpp>
+
+#include <tau/vector2d.h>
+#include <iris/gradient.h>
+#include <iris/chess/chess_solution.h>
+
+
+namespace chessboard
+{
+
+
+using Image = Eigen::MatrixX<float>;
+
+
+// A chessboard of squareSize squares, inset by a margin of one square, and
+// blurred like a camera image so that each vertex has four Harris peaks.
+// The board is moved right by shift.x and down by shift.y, which must be
+// less than a square.
+inline Image MakeChessboard(
+    Eigen::Index squareCount,
+    Eigen::Index squareSize,
+    const tau::Point2d<Eigen::Index> &shift = {0, 0})
+{
+    using Eigen::Index;
+
+    Index size = (squareCount + 2) * squareSize;
+    Image result = Image::Constant(size, size, 128.0f);
+
+    for (Index row = 0; row < squareCount * squareSize; ++row)
+    {
+        for (Index column = 0; column < squareCount * squareSize; ++column)
+        {
+            bool isLight = ((row / squareSize + column / squareSize) % 2) == 0;
+
+            Index boardRow = row + squareSize + shift.y;
+            Index boardColumn = column + squareSize + shift.x;
+            result(boardRow, boardColumn) = isLight ? 220.0f : 30.0f;
+        }
+    }
+
+    for (int pass = 0; pass < 3; ++pass)
+    {
+        Image blurred = result;
+
+        for (Index row = 2; row < size - 2; ++row)
+        {
+            for (Index column = 2; column < size - 2; ++column)
+            {
+                blurred(row, column) =
+                    result.block(row - 2, column - 2, 5, 5).mean();
+            }
+        }
+
+        result = blurred;
+    }
+
+    return result;
+}
+
+
+inline iris::GradientResult<float> GetGradient(const Image &image)
+{
+    auto differentiate =
+        iris::Differentiate<float>(255, 1, iris::DerivativeSize::Size::three);
+
+    auto gradient = iris::Gradient<float>(differentiate);
+
+    iris::GradientResult<float> result(255, image.rows(), image.cols());
+    REQUIRE(gradient.Filter(image, result));
+
+    return result;
+}
+
+
+// The interior vertices of the board made by MakeChessboard, moved by shift.
+inline iris::ChessSolution MakeSolution(
+    Eigen::Index squareCount,
+    Eigen::Index squareSize,
+    const tau::Point2d<double> &shift = {0.0, 0.0})
+{
+    iris::ChessSolution result;
+
+    // Squares change color between pixels, so the interior vertices lie
+    // half a pixel before each multiple of the square size.
+    for (Eigen::Index row = 0; row < squareCount - 1; ++row)
+    {
+        for (Eigen::Index column = 0; column < squareCount - 1; ++column)
+        {
+            iris::NamedVertex vertex{};
+
+            vertex.logical = tau::Point2d<size_t>(
+                static_cast<size_t>(column),
+                static_cast<size_t>(row));
+
+            vertex.pixel = tau::Point2d<double>(
+                static_cast<double>((column + 2) * squareSize) - 0.5 + shift.x,
+                static_cast<double>((row + 2) * squareSize) - 0.5 + shift.y);
+
+            result.vertices.push_back(vertex);
+        }
+    }
+
+    return result;
+}
+
+
+} // end namespace chessboard
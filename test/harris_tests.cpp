@@ -4,6 +4,8 @@
 #include <iris/suppression.h>
 #include <iris/gradient.h>
 
+#include "chessboard.h"
+
 
 TEST_CASE("Create Harris vertex detection class", "[harris]")
 {
@@ -62,3 +64,137 @@ TEST_CASE("Use suppression filter with count = 1", "[harris]")
 
     std::cout << "filtered: " << filtered << std::endl;
 }
+
+
+TEST_CASE("Harris at candidates matches the full response", "[harris]")
+{
+    using Eigen::Index;
+
+    static constexpr Index squareCount = 6;
+    static constexpr Index squareSize = 32;
+    static constexpr Index radius = 8;
+
+    auto gradient = chessboard::GetGradient(
+        chessboard::MakeChessboard(squareCount, squareSize));
+
+    // The threshold is relative to the largest value evaluated, which differs
+    // between the two, so only positive values are compared.
+    auto settings = iris::HarrisSettings<float>{};
+    settings.threshold = 0.0f;
+    settings.threads = 4;
+    iris::Harris<float> harris(settings);
+
+    using HarrisResult = typename iris::Harris<float>::Result;
+
+    HarrisResult full;
+    REQUIRE(harris.Filter(gradient, full));
+
+    // The vertices of the board.
+    std::vector<tau::Point2d<double>> candidates;
+
+    for (Index row = 1; row <= squareCount + 1; ++row)
+    {
+        for (Index column = 1; column <= squareCount + 1; ++column)
+        {
+            candidates.emplace_back(
+                static_cast<double>(column * squareSize),
+                static_cast<double>(row * squareSize));
+        }
+    }
+
+    HarrisResult sparse;
+    REQUIRE(harris.FilterCandidates(gradient, candidates, radius, sparse));
+    REQUIRE(sparse.rows() == full.rows());
+    REQUIRE(sparse.cols() == full.cols());
+
+    auto isNear = [&](const iris::LocalMaximum<float> &maximum)
+    {
+        for (auto &candidate: candidates)
+        {
+            if (std::abs(maximum.column - static_cast<Index>(candidate.x))
+                    <= radius
+                && std::abs(maximum.row - static_cast<Index>(candidate.y))
+                    <= radius)
+            {
+                return true;
+            }
+        }
+
+        return false;
+    };
+
+    HarrisResult::Maxima expected;
+
+    for (auto &maximum: full.maxima)
+    {
+        if (isNear(maximum))
+        {
+            expected.push_back(maximum);
+        }
+    }
+
+    REQUIRE(!expected.empty());
+    REQUIRE(sparse.maxima.size() == expected.size());
+
+    for (size_t index = 0; index < expected.size(); ++index)
+    {
+        REQUIRE(sparse.maxima[index].row == expected[index].row);
+        REQUIRE(sparse.maxima[index].column == expected[index].column);
+
+        REQUIRE(
+            sparse.maxima[index].value
+            == Approx(expected[index].value).epsilon(1e-5));
+    }
+}
+
+
+TEST_CASE("Intersections of lines are corner candidates", "[harris]")
+{
+    using Eigen::Index;
+
+    static constexpr Index squareCount = 6;
+    static constexpr Index squareSize = 32;
+    static constexpr Index imageSize = (squareCount + 2) * squareSize;
+
+    // The edges of the squares of the board.
+    std::vector<tau::Line2d<float>> lines;
+
+    for (Index index = 1; index <= squareCount + 1; ++index)
+    {
+        auto position = static_cast<float>(index * squareSize) - 0.5f;
+
+        lines.emplace_back(
+            tau::Point2d<float>(position, 0.0f),
+            tau::Vector2d<float>(0.0f, 1.0f));
+
+        lines.emplace_back(
+            tau::Point2d<float>(0.0f, position),
+            tau::Vector2d<float>(1.0f, 0.0f));
+    }
+
+    auto candidates =
+        iris::GetIntersections(lines, imageSize, imageSize, 20.0f);
+
+    // Parallel lines do not intersect.
+    auto lineCount = static_cast<size_t>(squareCount + 1);
+    REQUIRE(candidates.size() == lineCount * lineCount);
+
+    for (auto &candidate: candidates)
+    {
+        auto column = (candidate.x + 0.5) / static_cast<double>(squareSize);
+        auto row = (candidate.y + 0.5) / static_cast<double>(squareSize);
+
+        REQUIRE(column == Approx(std::round(column)).margin(1e-3));
+        REQUIRE(row == Approx(std::round(row)).margin(1e-3));
+    }
+
+    auto gradient = chessboard::GetGradient(
+        chessboard::MakeChessboard(squareCount, squareSize));
+
+    auto settings = iris::HarrisSettings<float>{};
+    iris::Harris<float> harris(settings);
+    typename iris::Harris<float>::Result result;
+
+    REQUIRE(harris.FilterCandidates(gradient, candidates, 8, result));
+    REQUIRE(!result.maxima.empty());
+}
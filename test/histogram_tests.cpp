@@ -0,0 +1,78 @@
+#include <catch2/catch.hpp>
+
+#include <iris/histogram.h>
+
+
+// The values 2, 5, 5, 9, 9.
+iris::Histogram MakeHistogram()
+{
+    iris::Histogram result(10);
+    result.counts[2] = 1;
+    result.counts[5] = 2;
+    result.counts[9] = 2;
+
+    return result;
+}
+
+
+TEST_CASE("Percentiles use the nearest rank", "[histogram]")
+{
+    auto histogram = MakeHistogram();
+
+    REQUIRE(histogram.GetTotal() == 5);
+    REQUIRE(*histogram.GetPercentile(0.0) == 2);
+    REQUIRE(*histogram.GetPercentile(0.5) == 5);
+    REQUIRE(*histogram.GetPercentile(1.0) == 9);
+
+    // Out of range percentiles are clamped.
+    REQUIRE(*histogram.GetPercentile(-1.0) == 2);
+    REQUIRE(*histogram.GetPercentile(2.0) == 9);
+}
+
+
+TEST_CASE("Percentiles skip the bins below firstBin", "[histogram]")
+{
+    auto histogram = MakeHistogram();
+
+    // The values 5, 5, 9, 9. The median rank rounds from 1.5 to 2.
+    REQUIRE(histogram.GetTotal(3) == 4);
+    REQUIRE(*histogram.GetPercentile(0.0, 3) == 5);
+    REQUIRE(*histogram.GetPercentile(0.5, 3) == 9);
+    REQUIRE(*histogram.GetPercentile(1.0, 3) == 9);
+
+    REQUIRE(!histogram.GetPercentile(0.5, 10));
+    REQUIRE(!iris::Histogram(10).GetPercentile(0.5));
+}
+
+
+TEST_CASE("Histograms sample every stride-th row and column", "[histogram]")
+{
+    using Eigen::Index;
+
+    auto toBin = [](Index row, Index column)
+    {
+        return static_cast<size_t>(row * 10 + column);
+    };
+
+    for (size_t threads: {1, 3})
+    {
+        auto histogram = iris::MakeHistogram(100, 10, 10, threads, 3, toBin);
+        REQUIRE(histogram.GetTotal() == 16);
+
+        for (Index row = 0; row < 10; ++row)
+        {
+            for (Index column = 0; column < 10; ++column)
+            {
+                bool isSampled = (row % 3 == 0) && (column % 3 == 0);
+
+                REQUIRE(
+                    histogram.counts[toBin(row, column)]
+                        == (isSampled ? 1 : 0));
+            }
+        }
+    }
+
+    REQUIRE_THROWS_AS(
+        iris::MakeHistogram(100, 10, 10, 1, 0, toBin),
+        iris::IrisError);
+}
@@ -0,0 +1,723 @@
+#include <catch2/catch.hpp>
+
+#include <numeric>
+#include <random>
+#include <iris/hough.h>
+
+
+static constexpr double imageWidth = 640;
+static constexpr double imageHeight = 480;
+
+
+// A line by its distance from the center of the image and the angle of its
+// normal in degrees, as the accumulator indexes it.
+struct TestLine
+{
+    double rho;
+    double degrees;
+};
+
+
+std::vector<TestLine> MakeTestLines()
+{
+    return {{50.3, 30.2}, {-80.7, 120.45}, {10.2, 89.7}, {120.0, 2.3}};
+}
+
+
+// Edge pixels along each line, with random weights.
+iris::CannyEdges MakeLineEdges(const std::vector<TestLine> &lines)
+{
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<float> weights(0.1f, 1.0f);
+
+    iris::CannyEdges result;
+
+    for (auto &line: lines)
+    {
+        auto radians = tau::ToRadians(line.degrees);
+        auto cosine = std::cos(radians);
+        auto sine = std::sin(radians);
+
+        for (double step = -400.0; step < 400.0; step += 1.0)
+        {
+            auto x = imageWidth / 2 + line.rho * cosine - step * sine;
+            auto y = imageHeight / 2 + line.rho * sine + step * cosine;
+
+            if (x < 0 || y < 0 || x > imageWidth - 1 || y > imageHeight - 1)
+            {
+                continue;
+            }
+
+            result.PushBack(
+                static_cast<Eigen::Index>(std::lround(y)),
+                static_cast<Eigen::Index>(std::lround(x)),
+                weights(generator),
+                static_cast<float>(line.degrees));
+        }
+    }
+
+    return result;
+}
+
+
+iris::HoughSettings<double> MakeSettings(bool weighted)
+{
+    iris::HoughSettings<double> settings;
+    settings.imageSize = draw::Size{640, 480};
+    settings.rhoCount = 800;
+    settings.thetaCount = 512;
+    settings.window = 12;
+    settings.weighted = weighted;
+    settings.threshold = (weighted) ? 20 : 40;
+
+    return settings;
+}
+
+
+template<typename Count>
+iris::HoughResult<double, Count> FilterHough(
+    const iris::HoughSettings<double> &settings,
+    const iris::CannyEdges &edges)
+{
+    iris::CannyResult<double> canny;
+    canny.edgeList = edges;
+
+    iris::HoughResult<double, Count> result;
+    REQUIRE(iris::Hough<double, Count>(settings).Filter(canny, result));
+    REQUIRE(result.space);
+
+    return result;
+}
+
+
+TEST_CASE("Integer Hough counts match double counts", "[hough]")
+{
+    auto edges = MakeLineEdges(MakeTestLines());
+
+    SECTION("Unweighted votes are exact")
+    {
+        auto settings = MakeSettings(false);
+        auto counted = FilterHough<uint32_t>(settings, edges);
+        auto expected = FilterHough<double>(settings, edges);
+
+        REQUIRE(counted.space->template cast<double>() == *expected.space);
+        REQUIRE(counted.lines.size() == expected.lines.size());
+    }
+
+    SECTION("Weighted votes are within the fixed-point rounding")
+    {
+        auto settings = MakeSettings(true);
+        auto counted = FilterHough<uint32_t>(settings, edges);
+        auto expected = FilterHough<double>(settings, edges);
+
+        Eigen::MatrixXd scaled =
+            counted.space->template cast<double>() / settings.weightScale;
+
+        // Each vote rounds by at most half of a count.
+        auto voteCount = static_cast<double>(edges.size());
+
+        REQUIRE(
+            (scaled - *expected.space).cwiseAbs().maxCoeff()
+                <= voteCount * 0.5 / settings.weightScale);
+
+        REQUIRE(counted.lines.size() == expected.lines.size());
+    }
+}
+
+
+TEST_CASE("Weighted 16-bit counts leave room above the threshold", "[hough]")
+{
+    using Accumulator16 = iris::Hough<double, uint16_t>::Accumulator;
+    using Accumulator32 = iris::Hough<double, uint32_t>::Accumulator;
+
+    iris::HoughSettings<double> settings;
+    settings.weighted = true;
+
+    auto scale = Accumulator16::GetWeightScale(settings);
+
+    REQUIRE(scale < settings.weightScale);
+
+    REQUIRE(
+        settings.threshold * scale * Accumulator16::thresholdHeadroom
+            <= std::numeric_limits<uint16_t>::max());
+
+    // Wide counts keep the requested scale.
+    REQUIRE(Accumulator32::GetWeightScale(settings) == settings.weightScale);
+
+    // Unweighted votes count one per edge.
+    settings.weighted = false;
+    REQUIRE(Accumulator16::GetWeightScale(settings) == 1.0);
+}
+
+
+TEST_CASE("Fixed-point votes match floating-point votes", "[hough]")
+{
+    using Index = Eigen::Index;
+    using Hough = iris::Hough<double>;
+
+    // A phase of 90 degrees with an angle range of 90 votes every theta
+    // except the last, which repeats the first.
+    auto edges = MakeLineEdges(MakeTestLines());
+    std::fill(std::begin(edges.phases), std::end(edges.phases), 90.0f);
+
+    auto settings = MakeSettings(false);
+    settings.angleRange = 90;
+    settings.threads = 3;
+
+    auto result = FilterHough<double>(settings, edges);
+    auto &space = *result.space;
+
+    Hough::Accumulator accumulator(settings);
+    Index lastTheta = accumulator.GetThetaCount() - 1;
+    Index lastRho = space.rows() - 1;
+
+    Eigen::MatrixXd expected =
+        Eigen::MatrixXd::Zero(space.rows(), space.cols());
+
+    for (size_t i = 0; i < edges.size(); ++i)
+    {
+        auto x = static_cast<double>(edges.columns[i]) - imageWidth / 2;
+        auto y = static_cast<double>(edges.rows[i]) - imageHeight / 2;
+
+        for (Index theta = 0; theta < lastTheta; ++theta)
+        {
+            auto angle = accumulator.ToTheta(theta);
+            auto rho = x * std::cos(angle) + y * std::sin(angle);
+
+            auto rhoIndex = std::clamp(
+                accumulator.ToRhoIndex(rho),
+                Index{0},
+                lastRho);
+
+            expected(rhoIndex, theta) += 1.0;
+        }
+    }
+
+    auto voteCount = static_cast<double>(edges.size());
+
+    REQUIRE(
+        space.leftCols(lastTheta).colwise().sum()
+        == expected.leftCols(lastTheta).colwise().sum());
+
+    REQUIRE((space.col(lastTheta).array() == 0.0).all());
+
+    // Fixed-point rounding can only move a vote that lies on the boundary
+    // between two rho indices to the neighboring index, so the running
+    // difference down each column is at most the few votes on one boundary.
+    Eigen::MatrixXd difference = space - expected;
+    auto moved = difference.cwiseAbs().sum() / 2;
+    REQUIRE(moved <= 0.001 * voteCount * static_cast<double>(lastTheta));
+
+    for (Index rho = 1; rho < difference.rows(); ++rho)
+    {
+        difference.row(rho) += difference.row(rho - 1);
+    }
+
+    REQUIRE(difference.cwiseAbs().maxCoeff() <= 4.0);
+}
+
+
+// The distance from the center of the image and the angle of the normal of
+// a detected line.
+TestLine ToTestLine(const tau::Line2d<double> &line)
+{
+    double normalX = line.vector.y;
+    double normalY = -line.vector.x;
+
+    double degrees = tau::ToDegrees(std::atan2(normalY, normalX));
+
+    double rho =
+        normalX * (line.point.x - imageWidth / 2)
+        + normalY * (line.point.y - imageHeight / 2);
+
+    if (degrees < 0)
+    {
+        degrees += 180;
+        rho = -rho;
+    }
+
+    return {rho, degrees};
+}
+
+
+TEST_CASE("Coarse-to-fine Hough refines lines", "[hough]")
+{
+    auto lines = MakeTestLines();
+    auto edges = MakeLineEdges(lines);
+
+    auto settings = MakeSettings(false);
+    settings.threshold = 100;
+    settings.window = 32;
+    settings.coarseFactor = 8;
+
+    auto result = FilterHough<uint32_t>(settings, edges);
+
+    // The coarse space has 1/8 of the resolution in rho and theta, with
+    // steps of about 8 pixels and 3 degrees.
+    REQUIRE(result.space->rows() == 100);
+    REQUIRE(result.space->cols() == 64);
+    REQUIRE(result.lines.size() == lines.size());
+
+    for (auto &expected: lines)
+    {
+        auto isMatch = [&](const tau::Line2d<double> &line)
+        {
+            auto found = ToTestLine(line);
+
+            return std::abs(found.degrees - expected.degrees) < 0.05
+                && std::abs(found.rho - expected.rho) < 0.1;
+        };
+
+        REQUIRE(
+            std::any_of(
+                std::begin(result.lines),
+                std::end(result.lines),
+                isMatch));
+    }
+}
+
+
+TEST_CASE("Orientation modes find two families of lines", "[hough]")
+{
+    // Two families of parallel lines, and a weaker line between them.
+    std::vector<TestLine> families{
+        {-150.0, 30.0},
+        {-20.0, 30.0},
+        {90.0, 30.0},
+        {-100.0, 120.0},
+        {40.0, 120.0},
+        {160.0, 120.0}};
+
+    auto edges = MakeLineEdges(families);
+    auto familyCount = edges.size();
+
+    // Edges on either side of a line have opposite phases.
+    for (size_t i = 0; i < edges.size(); i += 2)
+    {
+        edges.phases[i] += 180.0f;
+    }
+
+    edges.Append(MakeLineEdges({{0.0, 75.0}}));
+
+    double modeWidth = 10.0;
+    auto modes = iris::FindOrientationModes(edges, 2, modeWidth, false);
+
+    REQUIRE(modes.size() == 2);
+    std::sort(std::begin(modes), std::end(modes));
+    REQUIRE(iris::GetOrientationDifference(modes[0], 30.0) <= 1.0);
+    REQUIRE(iris::GetOrientationDifference(modes[1], 120.0) <= 1.0);
+
+    // The weaker line is the third mode.
+    auto third = iris::FindOrientationModes(edges, 3, modeWidth, false);
+    REQUIRE(third.size() == 3);
+    REQUIRE(iris::GetOrientationDifference(third[2], 75.0) <= 1.0);
+
+    auto selected = iris::SelectOrientationEdges(edges, modes, modeWidth);
+    REQUIRE(selected.size() == familyCount);
+
+    // Voting near the modes finds the lines of both families, and not the
+    // weaker line.
+    auto settings = MakeSettings(false);
+    settings.orientationModes = 2;
+    settings.modeWidth = modeWidth;
+
+    auto result = FilterHough<uint32_t>(settings, edges);
+    REQUIRE(result.lines.size() == families.size());
+
+    for (auto &line: result.lines)
+    {
+        auto found = ToTestLine(line);
+
+        auto isFamily = std::any_of(
+            std::begin(families),
+            std::end(families),
+            [&](const TestLine &family)
+            {
+                return std::abs(found.rho - family.rho) < 1.0
+                    && iris::GetOrientationDifference(
+                        found.degrees,
+                        family.degrees) < 1.0;
+            });
+
+        REQUIRE(isFamily);
+    }
+}
+
+
+// Moves a random tenth of the edges and drops another tenth, as a small
+// change between frames.
+iris::CannyEdges MoveEdges(
+    const iris::CannyEdges &edges,
+    std::mt19937 &generator)
+{
+    std::uniform_int_distribution<int> offsets(-2, 2);
+    std::uniform_int_distribution<int> choices(0, 9);
+
+    using Index = Eigen::Index;
+
+    iris::CannyEdges result;
+    result.reserve(edges.size());
+
+    for (size_t i = 0; i < edges.size(); ++i)
+    {
+        Index row = edges.rows[i];
+        Index column = edges.columns[i];
+
+        auto choice = choices(generator);
+
+        if (choice == 0)
+        {
+            continue;
+        }
+
+        if (choice == 1)
+        {
+            row = std::clamp(row + offsets(generator), Index{0}, Index{479});
+
+            column = std::clamp(
+                column + offsets(generator),
+                Index{0},
+                Index{639});
+        }
+
+        result.PushBack(row, column, edges.weights[i], edges.phases[i]);
+    }
+
+    return result;
+}
+
+
+// Returns the largest count of the rebuilt spaces.
+template<typename Count>
+Count CheckStreaming(const iris::HoughSettings<double> &settings)
+{
+    auto streamingSettings = settings;
+    streamingSettings.streaming = true;
+    streamingSettings.streamingLimit = 0.5;
+
+    iris::Hough<double, Count> streamed(streamingSettings);
+    iris::Hough<double, Count> rebuilt(settings);
+
+    std::mt19937 generator(7);
+    auto edges = MakeLineEdges(MakeTestLines());
+
+    // Results from the previous frame are kept, like a display would.
+    iris::HoughResult<double, Count> previous;
+    Count maximum = 0;
+
+    for (int frame = 0; frame < 8; ++frame)
+    {
+        auto moved = MoveEdges(edges, generator);
+
+        // Remove duplicate positions, which a Canny edge list cannot have.
+        auto order =
+            iris::Hough<double, Count>::Accumulator::SortByPosition(moved);
+
+        iris::CannyEdges unique;
+
+        for (size_t i = 0; i < order.size(); ++i)
+        {
+            auto index = order[i];
+
+            if (
+                i > 0
+                && moved.rows[index] == moved.rows[order[i - 1]]
+                && moved.columns[index] == moved.columns[order[i - 1]])
+            {
+                continue;
+            }
+
+            unique.PushBack(
+                moved.rows[index],
+                moved.columns[index],
+                moved.weights[index],
+                moved.phases[index]);
+        }
+
+        edges = unique;
+
+        iris::CannyResult<double> canny;
+        canny.edgeList = edges;
+
+        iris::HoughResult<double, Count> streamedResult;
+        iris::HoughResult<double, Count> rebuiltResult;
+        REQUIRE(streamed.Filter(canny, streamedResult));
+        REQUIRE(rebuilt.Filter(canny, rebuiltResult));
+
+        REQUIRE(*streamedResult.space == *rebuiltResult.space);
+        REQUIRE(streamedResult.lines.size() == rebuiltResult.lines.size());
+
+        previous = streamedResult;
+        maximum = std::max(maximum, rebuiltResult.space->maxCoeff());
+    }
+
+    return maximum;
+}
+
+
+TEST_CASE("Streamed Hough spaces match rebuilt spaces", "[hough]")
+{
+    SECTION("Unweighted")
+    {
+        CheckStreaming<uint32_t>(MakeSettings(false));
+    }
+
+    SECTION("Weighted")
+    {
+        CheckStreaming<uint32_t>(MakeSettings(true));
+    }
+
+    SECTION("Saturated")
+    {
+        // Weighted 16-bit cells saturate after a few hundred votes.
+        // The strongest line saturates in the first frames, and falls
+        // below saturation as edges are dropped.
+        auto settings = MakeSettings(true);
+        settings.weightScale = 384;
+
+        REQUIRE(
+            CheckStreaming<uint16_t>(settings)
+                == std::numeric_limits<uint16_t>::max());
+    }
+}
+
+
+using Accumulator = iris::Hough<double>::Accumulator;
+using Peak = Accumulator::Peak;
+using Peaks = Accumulator::Peaks;
+
+
+iris::HoughSettings<double> MakePeakSettings()
+{
+    auto settings = MakeSettings(false);
+    settings.rhoCount = 200;
+    settings.thetaCount = 128;
+    settings.window = 8;
+    settings.suppress = true;
+    settings.maximumLines = 0;
+
+    // Only the peaks decide which lines are kept.
+    settings.includeEdges = true;
+
+    return settings;
+}
+
+
+// The lines of peaks, taken without suppression.
+std::vector<tau::Line2d<double>> GetExpectedLines(
+    const iris::HoughSettings<double> &settings,
+    Peaks peaks)
+{
+    auto unsuppressed = settings;
+    unsuppressed.suppress = false;
+    unsuppressed.maximumLines = 0;
+
+    Accumulator accumulator(unsuppressed);
+
+    return accumulator.GetLines(peaks, unsuppressed);
+}
+
+
+bool IsSameLines(
+    const std::vector<tau::Line2d<double>> &first,
+    const std::vector<tau::Line2d<double>> &second)
+{
+    if (first.size() != second.size())
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < first.size(); ++i)
+    {
+        if (
+            first[i].point.x != second[i].point.x
+            || first[i].point.y != second[i].point.y
+            || first[i].vector.x != second[i].vector.x
+            || first[i].vector.y != second[i].vector.y)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+TEST_CASE("Sparse Hough peaks are suppressed across the seam", "[hough]")
+{
+    auto settings = MakePeakSettings();
+    Accumulator accumulator(settings);
+
+    auto rhoCount = static_cast<Eigen::Index>(settings.rhoCount);
+    auto lastTheta = accumulator.GetThetaCount() - 1;
+
+    // The first and last theta are both 0 degrees, where rho changes sign.
+    Eigen::Index rho = 60;
+    Eigen::Index mirroredRho = rhoCount - 1 - rho;
+
+    SECTION("Weaker peak near 180 degrees at the mirrored rho")
+    {
+        Peak strong{rho, 2, 100.0};
+        Peak weak{mirroredRho + 3, lastTheta - 3, 50.0};
+        Peaks peaks{weak, strong};
+
+        REQUIRE(
+            IsSameLines(
+                accumulator.GetLines(peaks, settings),
+                GetExpectedLines(settings, {strong})));
+    }
+
+    SECTION("Weaker peak near 0 degrees at the mirrored rho")
+    {
+        Peak strong{mirroredRho, lastTheta - 2, 100.0};
+        Peak weak{rho - 4, 1, 50.0};
+        Peaks peaks{strong, weak};
+
+        REQUIRE(
+            IsSameLines(
+                accumulator.GetLines(peaks, settings),
+                GetExpectedLines(settings, {strong})));
+    }
+
+    SECTION("Peaks on either side of the seam at the same rho")
+    {
+        Peak strong{rho, 2, 100.0};
+        Peak weak{rho, lastTheta - 3, 50.0};
+        Peaks peaks{weak, strong};
+
+        REQUIRE(
+            IsSameLines(
+                accumulator.GetLines(peaks, settings),
+                GetExpectedLines(settings, {strong, weak})));
+    }
+}
+
+
+TEST_CASE("Sparse Hough keeps the strongest lines", "[hough]")
+{
+    auto settings = MakePeakSettings();
+    settings.suppress = false;
+    settings.maximumLines = 3;
+
+    Peaks peaks{
+        {10, 10, 5.0},
+        {50, 40, 9.0},
+        {90, 70, 2.0},
+        {130, 100, 7.0},
+        {170, 20, 8.0},
+        {30, 120, 1.0}};
+
+    Accumulator accumulator(settings);
+    auto lines = accumulator.GetLines(peaks, settings);
+
+    REQUIRE(lines.size() == 3);
+
+    REQUIRE(
+        IsSameLines(
+            lines,
+            GetExpectedLines(
+                settings,
+                {{50, 40, 9.0}, {170, 20, 8.0}, {130, 100, 7.0}})));
+}
+
+
+TEST_CASE("Sparse Hough suppression matches a windowed search", "[hough]")
+{
+    using Index = Eigen::Index;
+
+    auto settings = MakePeakSettings();
+    Accumulator accumulator(settings);
+
+    auto rhoCount = static_cast<Index>(settings.rhoCount);
+    auto thetaCount = accumulator.GetThetaCount();
+    auto window = static_cast<Index>(settings.window);
+
+    // The last theta repeats the first, so it is never voted.
+    auto period = thetaCount - 1;
+
+    std::mt19937 generator(11);
+    std::uniform_int_distribution<Index> rhos(0, rhoCount - 1);
+    std::uniform_int_distribution<Index> thetas(0, period - 1);
+
+    // Crowd the seam, where the space wraps.
+    std::uniform_int_distribution<Index> seamThetas(-window, window - 1);
+
+    Eigen::MatrixXd space = Eigen::MatrixXd::Zero(rhoCount, thetaCount);
+    std::vector<std::pair<Index, Index>> cells;
+
+    for (int i = 0; i < 400; ++i)
+    {
+        Index theta = (i % 4 == 0)
+            ? (seamThetas(generator) + period) % period
+            : thetas(generator);
+
+        cells.emplace_back(rhos(generator), theta);
+    }
+
+    std::sort(std::begin(cells), std::end(cells));
+
+    cells.erase(
+        std::unique(std::begin(cells), std::end(cells)),
+        std::end(cells));
+
+    // Distinct counts, so that the strongest peak in every window is
+    // unique.
+    std::vector<double> counts(cells.size());
+    std::iota(std::begin(counts), std::end(counts), 1.0);
+    std::shuffle(std::begin(counts), std::end(counts), generator);
+
+    Peaks peaks;
+
+    for (size_t i = 0; i < cells.size(); ++i)
+    {
+        auto [rho, theta] = cells[i];
+        space(rho, theta) = counts[i];
+        peaks.push_back({rho, theta, counts[i]});
+    }
+
+    // A peak is kept when no cell within the window is larger. Across the
+    // seam, theta wraps by the period and rho changes sign.
+    Peaks kept;
+
+    for (auto &peak: peaks)
+    {
+        bool isMaximum = true;
+
+        for (Index dTheta = 1 - window; dTheta < window; ++dTheta)
+        {
+            for (Index dRho = 1 - window; dRho < window; ++dRho)
+            {
+                Index rho = peak.rho + dRho;
+                Index theta = peak.theta + dTheta;
+
+                if (theta < 0 || theta >= period)
+                {
+                    theta = (theta < 0) ? theta + period : theta - period;
+                    rho = rhoCount - 1 - rho;
+                }
+
+                if (rho < 0 || rho >= rhoCount)
+                {
+                    continue;
+                }
+
+                if (space(rho, theta) > peak.count)
+                {
+                    isMaximum = false;
+                }
+            }
+        }
+
+        if (isMaximum)
+        {
+            kept.push_back(peak);
+        }
+    }
+
+    REQUIRE(kept.size() < peaks.size());
+
+    REQUIRE(
+        IsSameLines(
+            accumulator.GetLines(peaks, settings),
+            GetExpectedLines(settings, kept)));
+}
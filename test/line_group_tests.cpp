@@ -0,0 +1,227 @@
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <tau/angular.h>
+
+#include <iris/chess/group_functions.h>
+
+
+using Line = iris::LineGroup::Line;
+
+
+Line MakeLine(double x, double y, double angle_deg)
+{
+    auto angle_rad = tau::ToRadians(angle_deg);
+
+    return Line(
+        tau::Point2d<double>(x, y),
+        tau::Vector2d<double>(std::cos(angle_rad), std::sin(angle_rad)));
+}
+
+
+// The mean of the doubled line angles, computed from scratch.
+double MeanLineAngle(const iris::LineGroup::LineCollection &lines)
+{
+    double sinSum = 0.0;
+    double cosSum = 0.0;
+
+    for (auto &line: lines)
+    {
+        double doubled = 2.0 * tau::ToRadians(line.GetAngleDegrees());
+        sinSum += std::sin(doubled);
+        cosSum += std::cos(doubled);
+    }
+
+    double result = tau::ToDegrees(std::atan2(sinSum, cosSum)) / 2.0;
+
+    if (result < 0.0)
+    {
+        result += 180.0;
+    }
+
+    return result;
+}
+
+
+// The group order produced when each split was prepended to the result.
+template<typename Split>
+iris::Groups PrependSplits(const iris::Groups &groups, const Split &split)
+{
+    iris::Groups result;
+
+    for (auto group: groups)
+    {
+        auto splitGroups = split(group);
+        result.insert(begin(result), begin(splitGroups), end(splitGroups));
+    }
+
+    return result;
+}
+
+
+std::string ToString(const iris::Groups &groups)
+{
+    std::ostringstream outputStream;
+    outputStream << groups;
+
+    return outputStream.str();
+}
+
+
+TEST_CASE("Lines on either side of 0 degrees share a group", "[line_group]")
+{
+    iris::Groups groups;
+
+    iris::AddLineToGroups(groups, MakeLine(0.0, 0.0, 1.0), 5.0);
+    iris::AddLineToGroups(groups, MakeLine(10.0, 0.0, 179.0), 5.0);
+
+    REQUIRE(groups.size() == 1);
+    REQUIRE(groups.front().lines.size() == 2);
+
+    double angle = groups.front().angle;
+    REQUIRE(std::min(angle, 180.0 - angle) == Approx(0.0).margin(1e-6));
+}
+
+
+TEST_CASE("Running line group angle matches the mean", "[line_group]")
+{
+    iris::LineGroup group(MakeLine(0.0, 0.0, 30.0));
+    group.AddLine(MakeLine(10.0, 0.0, 32.0));
+    group.AddLine(MakeLine(20.0, 0.0, 37.0));
+
+    REQUIRE(group.angle == Approx(MeanLineAngle(group.lines)));
+
+    iris::LineGroup other(MakeLine(30.0, 0.0, 41.0));
+    other.AddLine(MakeLine(40.0, 0.0, 44.0));
+
+    group.Combine(other);
+
+    REQUIRE(group.lines.size() == 5);
+    REQUIRE(group.angle == Approx(MeanLineAngle(group.lines)));
+
+    group.AddLine(MakeLine(50.0, 0.0, 45.0));
+
+    REQUIRE(group.angle == Approx(MeanLineAngle(group.lines)));
+}
+
+
+TEST_CASE("Removing outlier lines rebuilds the angle sums", "[line_group]")
+{
+    iris::LineGroup group(MakeLine(0.0, 0.0, 40.0));
+
+    for (auto angle: {40.5, 41.0, 41.5, 42.0, 70.0})
+    {
+        group.AddLine(MakeLine(0.0, 0.0, angle));
+    }
+
+    group.RemoveOutlierLines();
+
+    // The line at 70 degrees is far outside the interquartile range.
+    REQUIRE(group.lines.size() < 6);
+
+    group.AddLine(MakeLine(0.0, 0.0, 41.2));
+
+    REQUIRE(group.angle == Approx(MeanLineAngle(group.lines)));
+}
+
+
+TEST_CASE("Splitting groups preserves the group order", "[line_group]")
+{
+    SECTION("Split on spacing")
+    {
+        iris::LineGroup vertical(MakeLine(0.0, 0.0, 90.0));
+
+        for (auto x: {10.0, 20.0, 100.0, 110.0})
+        {
+            vertical.AddLine(MakeLine(x, 0.0, 90.0));
+        }
+
+        iris::LineGroup horizontal(MakeLine(0.0, 0.0, 0.0));
+
+        for (auto y: {10.0, 20.0, 30.0, 200.0, 210.0})
+        {
+            horizontal.AddLine(MakeLine(0.0, y, 0.0));
+        }
+
+        iris::Groups groups{vertical, horizontal};
+
+        auto expected = PrependSplits(
+            groups,
+            [](iris::LineGroup &group)
+            {
+                group.SortByPosition(false);
+                return group.SplitOnSpacing(50.0, 2.0);
+            });
+
+        iris::SplitGroupsOnSpacing(groups, 50.0, 2.0);
+
+        REQUIRE(groups.size() == 4);
+        REQUIRE(ToString(groups) == ToString(expected));
+    }
+
+    SECTION("Split on angles")
+    {
+        iris::LineGroup first(MakeLine(0.0, 0.0, 30.0));
+
+        for (auto angle: {30.2, 30.4, 30.6, 35.0, 35.2, 35.4, 35.6, 50.0})
+        {
+            first.AddLine(MakeLine(0.0, 0.0, angle));
+        }
+
+        iris::LineGroup second(MakeLine(0.0, 0.0, 120.0));
+
+        for (auto angle: {120.2, 120.4, 120.6, 140.0})
+        {
+            second.AddLine(MakeLine(0.0, 0.0, angle));
+        }
+
+        iris::Groups groups{first, second};
+
+        auto expected = PrependSplits(
+            groups,
+            [](iris::LineGroup &group)
+            {
+                return group.SplitOnAngles();
+            });
+
+        iris::SplitGroupsOnAngles(groups);
+
+        REQUIRE(groups.size() > 2);
+        REQUIRE(ToString(groups) == ToString(expected));
+    }
+
+    SECTION("Split on missing lines")
+    {
+        iris::LineGroup vertical(MakeLine(0.0, 0.0, 90.0));
+
+        for (auto x: {10.0, 20.0, 30.0, 60.0, 70.0, 80.0})
+        {
+            vertical.AddLine(MakeLine(x, 0.0, 90.0));
+        }
+
+        iris::LineGroup horizontal(MakeLine(0.0, 0.0, 0.0));
+
+        for (auto y: {10.0, 20.0, 50.0, 60.0, 70.0})
+        {
+            horizontal.AddLine(MakeLine(0.0, y, 0.0));
+        }
+
+        iris::Groups groups{vertical, horizontal};
+
+        auto expected = PrependSplits(
+            groups,
+            [](iris::LineGroup &group)
+            {
+                return group.SplitOnMissingLines(0.5);
+            });
+
+        iris::SplitMissingLines(groups, 0.5);
+
+        REQUIRE(groups.size() > 2);
+        REQUIRE(ToString(groups) == ToString(expected));
+    }
+}
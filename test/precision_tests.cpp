@@ -0,0 +1,190 @@
+#include <catch2/catch.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <optional>
+#include <iris/canny.h>
+#include <iris/hough.h>
+#include <iris/harris.h>
+#include <iris/vertex.h>
+#include <iris/chess.h>
+
+#include "chessboard.h"
+
+
+using chessboard::MakeChessboard;
+using chessboard::GetGradient;
+using chessboard::MakeSolution;
+
+
+// Runs both branches of the chess chain at the precision of Float: Canny and
+// Hough for the lines, and Harris and VertexFinder for the vertices.
+template<typename Float>
+iris::ChessSolution FindSolution(
+    const iris::GradientResult<float> &gradient,
+    Eigen::Index imageSize)
+{
+    auto cannySettings = iris::CannySettings<Float>{};
+
+    // The blurred board has a low gradient magnitude.
+    cannySettings.range.low = static_cast<Float>(0.02);
+    cannySettings.range.high = static_cast<Float>(0.05);
+
+    iris::CannyResult<Float> canny;
+    REQUIRE(iris::Canny<Float>(cannySettings).Filter(gradient, canny));
+
+    auto houghSettings = iris::HoughSettings<Float>{};
+    auto size = static_cast<int>(imageSize);
+    houghSettings.imageSize = draw::Size{size, size};
+    houghSettings.weighted = false;
+    houghSettings.threshold = 60;
+
+    // Theta runs from 0 to 180 degrees in thetaCount - 1 steps. An odd count
+    // puts a bin at 90 degrees, so the horizontal lines of the board do not
+    // split their votes between two bins.
+    houghSettings.thetaCount = 1023;
+
+    iris::HoughResult<Float, uint32_t> hough;
+    REQUIRE(iris::Hough<Float, uint32_t>(houghSettings).Filter(canny, hough));
+
+    auto harrisSettings = iris::HarrisSettings<Float>{};
+    harrisSettings.threads = 4;
+
+    typename iris::Harris<Float>::Result harris;
+    REQUIRE(iris::Harris<Float>(harrisSettings).Filter(gradient, harris));
+
+    iris::VertexFinder vertexFinder(iris::VertexSettings{});
+    iris::VertexSet vertices;
+    REQUIRE(vertexFinder.Filter(harris, vertices));
+
+    iris::ChessSolution result;
+
+    REQUIRE(
+        iris::Chess(iris::ChessSettings{}).Filter(
+            iris::ChessInput(vertices, hough),
+            result));
+
+    return result;
+}
+
+
+// The logical indices of a square board depend on which group of lines is
+// found first, so vertices are matched by their pixel positions.
+std::optional<iris::NamedVertex> FindNamedVertex(
+    const iris::NamedVertices &vertices,
+    const tau::Point2d<double> &pixel,
+    double tolerance)
+{
+    for (auto &vertex: vertices)
+    {
+        if (
+            std::abs(vertex.pixel.x - pixel.x) <= tolerance
+            && std::abs(vertex.pixel.y - pixel.y) <= tolerance)
+        {
+            return vertex;
+        }
+    }
+
+    return {};
+}
+
+
+double GetWorstError(
+    const iris::ChessSolution &solution,
+    const iris::ChessSolution &expected)
+{
+    double worstError = 0.0;
+
+    for (auto &vertex: expected.vertices)
+    {
+        auto found = FindNamedVertex(solution.vertices, vertex.pixel, 1.0);
+
+        if (!found)
+        {
+            return std::numeric_limits<double>::infinity();
+        }
+
+        worstError = std::max(
+            worstError,
+            std::hypot(
+                found->pixel.x - vertex.pixel.x,
+                found->pixel.y - vertex.pixel.y));
+    }
+
+    return worstError;
+}
+
+
+TEST_CASE(
+    "Single-precision chess vertices match double precision",
+    "[precision]")
+{
+    static constexpr Eigen::Index squareCount = 6;
+    static constexpr Eigen::Index squareSize = 32;
+    static constexpr Eigen::Index imageSize = (squareCount + 2) * squareSize;
+
+    auto gradient = GetGradient(MakeChessboard(squareCount, squareSize));
+    auto expected = MakeSolution(squareCount, squareSize);
+
+    auto solution = FindSolution<double>(gradient, imageSize);
+    auto floatSolution = FindSolution<float>(gradient, imageSize);
+
+    REQUIRE(solution.vertices.size() == expected.vertices.size());
+    REQUIRE(floatSolution.vertices.size() == expected.vertices.size());
+
+    REQUIRE(GetWorstError(solution, expected) < 0.1);
+    REQUIRE(GetWorstError(floatSolution, expected) < 0.1);
+
+    for (auto &vertex: solution.vertices)
+    {
+        auto floatVertex =
+            FindNamedVertex(floatSolution.vertices, vertex.pixel, 1e-3);
+
+        REQUIRE(floatVertex);
+    }
+}
+
+
+// Hidden by default. Run with: iris_tests "[.benchmark]"
+TEST_CASE("Chess vertex precision benchmark", "[.benchmark]")
+{
+    using Clock = std::chrono::steady_clock;
+    using Period = std::chrono::duration<double, std::milli>;
+
+    static constexpr Eigen::Index squareCount = 12;
+    static constexpr Eigen::Index squareSize = 80;
+    static constexpr Eigen::Index imageSize = (squareCount + 2) * squareSize;
+
+    auto gradient = GetGradient(MakeChessboard(squareCount, squareSize));
+    auto expected = MakeSolution(squareCount, squareSize);
+    static constexpr int iterations = 10;
+
+    auto time = [&](auto findSolution)
+    {
+        auto begin = Clock::now();
+
+        for (int iteration = 0; iteration < iterations; ++iteration)
+        {
+            findSolution(gradient, imageSize);
+        }
+
+        return Period(Clock::now() - begin).count() / iterations;
+    };
+
+    auto doubleTime = time(FindSolution<double>);
+    auto floatTime = time(FindSolution<float>);
+
+    auto solution = FindSolution<double>(gradient, imageSize);
+    auto floatSolution = FindSolution<float>(gradient, imageSize);
+
+    std::cout << "double: " << doubleTime << " ms, "
+        << solution.vertices.size() << " vertices, worst error "
+        << GetWorstError(solution, expected) << " pixels\n"
+        << "float: " << floatTime << " ms, "
+        << floatSolution.vertices.size() << " vertices, worst error "
+        << GetWorstError(floatSolution, expected) << " pixels" << std::endl;
+
+    REQUIRE(floatSolution.vertices.size() == solution.vertices.size());
+}
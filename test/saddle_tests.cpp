@@ -0,0 +1,125 @@
+#include <catch2/catch.hpp>
+
+#include <iris/gaussian.h>
+#include <iris/saddle.h>
+
+#include "chessboard.h"
+
+
+TEST_CASE("Second derivative of Gaussian samples", "[saddle]")
+{
+    auto kernel = iris::Sample<double, 2>(2.0, 21);
+
+    // Symmetric, negative at the center, and summing to about zero.
+    REQUIRE(kernel(0) == Approx(kernel(20)));
+    REQUIRE(kernel(10) < 0.0);
+    REQUIRE(kernel.sum() == Approx(0.0).margin(1e-3));
+
+    // The second moment of the second derivative is 2.
+    Eigen::VectorX<double> x = Eigen::VectorX<double>::LinSpaced(21, -10, 10);
+    REQUIRE(
+        (x.array().square() * kernel.array()).sum()
+        == Approx(2.0).epsilon(1e-3));
+}
+
+
+TEMPLATE_TEST_CASE("Saddles are found at chessboard vertices", "[saddle]",
+    float, double)
+{
+    using Eigen::Index;
+
+    static constexpr Index squareCount = 6;
+    static constexpr Index squareSize = 32;
+
+    auto image = chessboard::MakeChessboard(squareCount, squareSize);
+
+    iris::SaddleSettings settings;
+    iris::Saddle<TestType> saddle(settings);
+
+    iris::VertexSet vertices;
+    REQUIRE(saddle.Filter(image, vertices));
+    REQUIRE(!vertices.empty());
+    REQUIRE(vertices.valuePoints.size() == vertices.size());
+
+    // Squares change color between pixels, so the interior vertices lie
+    // half a pixel before each multiple of the square size.
+    for (Index row = 2; row <= squareCount; ++row)
+    {
+        for (Index column = 2; column <= squareCount; ++column)
+        {
+            tau::Point2d<double> expected(
+                static_cast<double>(column * squareSize) - 0.5,
+                static_cast<double>(row * squareSize) - 0.5);
+
+            bool isFound = false;
+
+            for (size_t index = 0; index < vertices.size(); ++index)
+            {
+                auto difference = vertices.GetPoint(index) - expected;
+
+                if (difference.SquaredSum() < 0.1 * 0.1)
+                {
+                    isFound = true;
+                    break;
+                }
+            }
+
+            INFO(expected);
+            REQUIRE(isFound);
+        }
+    }
+}
+
+
+TEMPLATE_TEST_CASE("Saddle bands match across thread counts", "[saddle]",
+    float, double)
+{
+    using Eigen::Index;
+
+    static constexpr Index squareCount = 6;
+    static constexpr Index squareSize = 32;
+
+    // An odd row count leaves a partial band at the bottom of the image.
+    auto board = chessboard::MakeChessboard(squareCount, squareSize);
+    chessboard::Image image = board.topRows(board.rows() - 3);
+
+    iris::SaddleSettings settings;
+
+    // With more threads than rows per band, each chunk holds a single band,
+    // so no filtered rows are handed from one band to the next.
+    settings.threads = 64;
+
+    iris::VertexSet expected;
+    REQUIRE(iris::Saddle<TestType>(settings).Filter(image, expected));
+    REQUIRE(!expected.empty());
+
+    auto threads = GENERATE(size_t{1}, size_t{3}, size_t{4});
+    settings.threads = threads;
+
+    iris::VertexSet vertices;
+    REQUIRE(iris::Saddle<TestType>(settings).Filter(image, vertices));
+
+    INFO("threads: " << threads);
+    REQUIRE(vertices.size() == expected.size());
+
+    for (size_t index = 0; index < expected.size(); ++index)
+    {
+        auto point = expected.GetPoint(index);
+        bool isFound = false;
+
+        for (size_t other = 0; other < vertices.size(); ++other)
+        {
+            if (
+                vertices.GetPoint(other) == point
+                && vertices.valuePoints[other].value
+                    == expected.valuePoints[index].value)
+            {
+                isFound = true;
+                break;
+            }
+        }
+
+        INFO(point);
+        REQUIRE(isFound);
+    }
+}
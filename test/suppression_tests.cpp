@@ -1,6 +1,11 @@
 #include <catch2/catch.hpp>
 
+#include <algorithm>
+#include <random>
+#include <vector>
+
 #include <iris/suppression.h>
+#include <iris/detail/running_maximum.h>
 
 
 TEST_CASE("Column-major threaded suppression", "[suppression]")
@@ -260,3 +265,282 @@ TEST_CASE("Row-major decreasing values within window", "[suppression]")
     REQUIRE(result(9, 2) == 0.0);
     REQUIRE(result(9, 3) == 0.0);
 }
+
+
+// Keeps non-zero values that have no larger value within windowSize - 1, and
+// no kept equal value earlier in storage order.
+template<typename Matrix>
+Matrix BruteForceSuppression(Eigen::Index windowSize, const Matrix &input)
+{
+    using Eigen::Index;
+
+    Matrix result = Matrix::Zero(input.rows(), input.cols());
+    Index reach = windowSize - 1;
+
+    Index outerCount = Matrix::IsRowMajor ? input.rows() : input.cols();
+    Index innerCount = Matrix::IsRowMajor ? input.cols() : input.rows();
+
+    auto at = [](auto &matrix, Index outer, Index inner) -> auto &
+    {
+        return Matrix::IsRowMajor ? matrix(outer, inner) : matrix(inner, outer);
+    };
+
+    for (Index outer = 0; outer < outerCount; ++outer)
+    {
+        for (Index inner = 0; inner < innerCount; ++inner)
+        {
+            auto value = at(input, outer, inner);
+
+            if (value == 0)
+            {
+                continue;
+            }
+
+            bool isKept = true;
+
+            for (
+                Index i = std::max(Index{0}, outer - reach);
+                i <= std::min(outerCount - 1, outer + reach);
+                ++i)
+            {
+                for (
+                    Index j = std::max(Index{0}, inner - reach);
+                    j <= std::min(innerCount - 1, inner + reach);
+                    ++j)
+                {
+                    bool isEarlier = (i < outer) || (i == outer && j < inner);
+
+                    if (
+                            at(input, i, j) > value
+                            || (isEarlier && at(result, i, j) == value))
+                    {
+                        isKept = false;
+                    }
+                }
+            }
+
+            if (isKept)
+            {
+                at(result, outer, inner) = value;
+            }
+        }
+    }
+
+    return result;
+}
+
+
+TEMPLATE_TEST_CASE(
+    "Running maximum suppression matches brute force",
+    "[suppression]",
+    Eigen::MatrixX<int>,
+    (Eigen::Matrix<int, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>))
+{
+    using Matrix = TestType;
+
+    auto windowSize = GENERATE(
+        Eigen::Index{1},
+        Eigen::Index{2},
+        Eigen::Index{3},
+        Eigen::Index{7},
+        Eigen::Index{40});
+
+    auto threadCount = GENERATE(size_t{1}, size_t{3}, size_t{16});
+
+    // Few distinct values, so that plateaus of equal maxima are common.
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<int> distribution(0, 4);
+
+    Matrix m = Matrix::NullaryExpr(
+        37,
+        29,
+        [&]()
+        {
+            return distribution(generator);
+        });
+
+    Matrix result;
+    iris::Suppression(threadCount, windowSize, m, result);
+
+    REQUIRE(result == BruteForceSuppression(windowSize, m));
+}
+
+
+TEMPLATE_TEST_CASE(
+    "Sparse suppression matches dense suppression",
+    "[suppression]",
+    Eigen::MatrixX<double>,
+    (Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>))
+{
+    using Matrix = TestType;
+
+    auto windowSize = GENERATE(
+        Eigen::Index{1},
+        Eigen::Index{3},
+        Eigen::Index{8},
+        Eigen::Index{50});
+
+    auto threadCount = GENERATE(size_t{1}, size_t{4});
+
+    std::mt19937 generator(7);
+    std::uniform_int_distribution<int> distribution(0, 19);
+
+    // Mostly zero, with some equal values.
+    Matrix m = Matrix::NullaryExpr(
+        45,
+        33,
+        [&]()
+        {
+            auto value = distribution(generator);
+            return (value < 16) ? 0.0 : static_cast<double>(value);
+        });
+
+    Matrix dense;
+    iris::Suppression(threadCount, windowSize, m, dense);
+
+    Matrix sparse;
+    iris::SparseSuppression(threadCount, windowSize, m, sparse);
+
+    REQUIRE(sparse == dense);
+}
+
+
+TEST_CASE("Local maxima are listed in storage order", "[suppression]")
+{
+    using Matrix =
+        Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+
+    Matrix m = Matrix::Zero(12, 12);
+    m(1, 9) = 3.0f;
+    m(2, 8) = 2.0f;
+    m(6, 2) = 5.0f;
+    m(10, 10) = 1.0f;
+
+    auto maxima = iris::FindLocalMaxima(2, 3, m);
+
+    REQUIRE(maxima.size() == 3);
+
+    REQUIRE(maxima[0].row == 1);
+    REQUIRE(maxima[0].column == 9);
+    REQUIRE(maxima[0].value == 3.0f);
+
+    REQUIRE(maxima[1].row == 6);
+    REQUIRE(maxima[1].column == 2);
+
+    REQUIRE(maxima[2].row == 10);
+    REQUIRE(maxima[2].column == 10);
+
+    Matrix dense;
+    iris::MaximaToMatrix(maxima, m.rows(), m.cols(), dense);
+
+    Matrix suppressed;
+    iris::Suppression(2, 3, m, suppressed);
+
+    REQUIRE(dense == suppressed);
+}
+
+
+TEST_CASE(
+    "Running maximum counts the values equal to each maximum",
+    "[suppression]")
+{
+    using RunningMaximum = iris::detail::RunningMaximum;
+    using Index = Eigen::Index;
+    using Count = RunningMaximum::Count;
+    using Lines = Eigen::ArrayXX<int>;
+
+    auto reach = GENERATE(Index{0}, Index{1}, Index{2}, Index{3}, Index{6});
+
+    std::vector<int> input{1, 5, 2, 3, 0, 4, 7, 1, 2, 4, 4, 0, 3};
+    auto count = static_cast<Index>(input.size());
+
+    std::vector<int> expected(input.size());
+    std::vector<Count> expectedCounts(input.size());
+
+    for (Index index = 0; index < count; ++index)
+    {
+        Index first = std::max(Index{0}, index - reach);
+        Index last = std::min(count - 1, index + reach);
+
+        int maximum = *std::max_element(
+            input.begin() + first,
+            input.begin() + last + 1);
+
+        expected[static_cast<size_t>(index)] = maximum;
+
+        expectedCounts[static_cast<size_t>(index)] =
+            static_cast<Count>(std::count(
+                input.begin() + first,
+                input.begin() + last + 1,
+                maximum));
+    }
+
+    RunningMaximum runningMaximum(reach);
+    auto paddedSize =
+        static_cast<size_t>(runningMaximum.GetPaddedCount(count));
+
+    std::vector<int> forward(paddedSize);
+    std::vector<Count> forwardCounts(paddedSize);
+    std::vector<int> backward(paddedSize);
+    std::vector<Count> backwardCounts(paddedSize);
+
+    std::vector<int> output(input.size());
+    std::vector<Count> outputCounts(input.size());
+
+    runningMaximum.Along(
+        input.data(),
+        output.data(),
+        outputCounts.data(),
+        count,
+        forward.data(),
+        forwardCounts.data(),
+        backward.data(),
+        backwardCounts.data());
+
+    REQUIRE(output == expected);
+    REQUIRE(outputCounts == expectedCounts);
+
+    // Across filters each row as a line of column elements.
+    Index rowCount = 2;
+    Lines lines(rowCount, count);
+    RunningMaximum::Counts lineCounts =
+        RunningMaximum::Counts::Ones(rowCount, count);
+
+    for (Index index = 0; index < count; ++index)
+    {
+        lines(0, index) = input[static_cast<size_t>(index)];
+        lines(1, index) = input[static_cast<size_t>(count - 1 - index)];
+    }
+
+    Index paddedCount = runningMaximum.GetPaddedCount(count);
+    Lines forwardLines(rowCount, paddedCount);
+    RunningMaximum::Counts forwardLineCounts(rowCount, paddedCount);
+    Lines backwardLines(rowCount, paddedCount);
+    RunningMaximum::Counts backwardLineCounts(rowCount, paddedCount);
+
+    Lines maxima(rowCount, count);
+    RunningMaximum::Counts maximaCounts(rowCount, count);
+
+    runningMaximum.Across(
+        lines,
+        lineCounts,
+        maxima,
+        maximaCounts,
+        0,
+        rowCount,
+        forwardLines,
+        forwardLineCounts,
+        backwardLines,
+        backwardLineCounts);
+
+    for (Index index = 0; index < count; ++index)
+    {
+        auto forwardIndex = static_cast<size_t>(index);
+        auto reverseIndex = static_cast<size_t>(count - 1 - index);
+
+        REQUIRE(maxima(0, index) == expected[forwardIndex]);
+        REQUIRE(maximaCounts(0, index) == expectedCounts[forwardIndex]);
+        REQUIRE(maxima(1, index) == expected[reverseIndex]);
+        REQUIRE(maximaCounts(1, index) == expectedCounts[reverseIndex]);
+    }
+}
@@ -0,0 +1,253 @@
+#include <catch2/catch.hpp>
+
+#include <map>
+#include <random>
+
+#include <iris/vertex.h>
+#include <iris/chess/find_vertex.h>
+
+
+// Groups points by comparing each one to every group.
+iris::VertexSet BruteForceGroups(
+    double radius,
+    size_t count,
+    const iris::LocalMaxima<double> &maxima)
+{
+    std::map<tau::Point2d<double>, iris::ValuePoints> groups;
+
+    for (auto &maximum: maxima)
+    {
+        draw::ValuePoint<double> point(
+            static_cast<double>(maximum.column),
+            static_cast<double>(maximum.row),
+            maximum.value);
+
+        auto group = std::find_if(
+            groups.begin(),
+            groups.end(),
+            [&](const auto &entry)
+            {
+                return (point - entry.first).SquaredSum() < radius * radius;
+            });
+
+        if (group == groups.end())
+        {
+            groups[point].push_back(point);
+        }
+        else
+        {
+            group->second.push_back(point);
+        }
+    }
+
+    iris::VertexSet result;
+
+    for (auto & [seed, group]: groups)
+    {
+        if (group.size() > 4)
+        {
+            std::sort(
+                group.begin(),
+                group.end(),
+                [](const auto &first, const auto &second)
+                {
+                    return first.value > second.value;
+                });
+
+            group.resize(4);
+        }
+
+        double maximumValue = 0.0;
+
+        for (auto &point: group)
+        {
+            maximumValue = std::max(maximumValue, point.value);
+        }
+
+        for (auto &point: group)
+        {
+            point.value /= maximumValue;
+        }
+
+        auto centroid = iris::detail::GetCentroid(
+            count,
+            group.cbegin(),
+            group.cend());
+
+        if (centroid)
+        {
+            result.Add(*centroid, group.cbegin(), group.cend());
+        }
+    }
+
+    return result;
+}
+
+
+TEST_CASE("Grid-hashed point groups match brute force", "[vertex]")
+{
+    using Eigen::Index;
+
+    static constexpr Index rows = 120;
+    static constexpr Index columns = 160;
+
+    auto radius = GENERATE(2.0, 3.0, 7.5);
+    auto count = GENERATE(size_t{2}, size_t{4});
+
+    // Clusters of nearby points, listed in row-major order like the
+    // maxima of the Harris response.
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<Index> rowDistribution(0, rows - 1);
+    std::uniform_int_distribution<Index> columnDistribution(0, columns - 1);
+    std::uniform_int_distribution<Index> offsetDistribution(-4, 4);
+    std::uniform_real_distribution<double> valueDistribution(1.0, 100.0);
+
+    std::map<std::pair<Index, Index>, double> points;
+
+    for (int cluster = 0; cluster < 300; ++cluster)
+    {
+        Index row = rowDistribution(generator);
+        Index column = columnDistribution(generator);
+
+        for (int point = 0; point < 6; ++point)
+        {
+            Index pointRow = row + offsetDistribution(generator);
+            Index pointColumn = column + offsetDistribution(generator);
+
+            if (pointRow < 0 || pointRow >= rows
+                || pointColumn < 0 || pointColumn >= columns)
+            {
+                continue;
+            }
+
+            points[{pointRow, pointColumn}] = valueDistribution(generator);
+        }
+    }
+
+    iris::LocalMaxima<double> maxima;
+
+    for (auto & [position, value]: points)
+    {
+        maxima.push_back({position.second, position.first, value});
+    }
+
+    iris::detail::PointGroups pointGroups(radius, count);
+    pointGroups.AddMaxima(maxima);
+
+    auto vertices = pointGroups.GetVertices();
+    auto expected = BruteForceGroups(radius, count, maxima);
+
+    REQUIRE(!expected.empty());
+    REQUIRE(vertices.size() == expected.size());
+
+    for (size_t index = 0; index < expected.size(); ++index)
+    {
+        REQUIRE(vertices.GetPoint(index) == expected.GetPoint(index));
+        REQUIRE(vertices.count[index] == expected.count[index]);
+
+        auto valuePoints = vertices.GetValuePoints(index);
+        auto expectedPoints = expected.GetValuePoints(index);
+        REQUIRE(valuePoints.size() == expectedPoints.size());
+
+        for (size_t point = 0; point < expectedPoints.size(); ++point)
+        {
+            REQUIRE(valuePoints[point].x == expectedPoints[point].x);
+            REQUIRE(valuePoints[point].y == expectedPoints[point].y);
+            REQUIRE(valuePoints[point].value == expectedPoints[point].value);
+        }
+    }
+}
+
+
+TEST_CASE("Point groups are built from a matrix", "[vertex]")
+{
+    tau::MonoImage<float> image = tau::MonoImage<float>::Zero(20, 20);
+    image(5, 5) = 1.0f;
+    image(5, 6) = 2.0f;
+    image(6, 5) = 3.0f;
+    image(6, 6) = 4.0f;
+    image(15, 15) = 1.0f;
+
+    iris::detail::PointGroups pointGroups(3.0, 4);
+    pointGroups.AddMatrix(2, image);
+
+    auto vertices = pointGroups.GetVertices();
+
+    REQUIRE(vertices.size() == 1);
+    REQUIRE(vertices.x[0] == Approx(5.5));
+    REQUIRE(vertices.y[0] == Approx(5.5));
+    REQUIRE(vertices.count[0] == 4);
+    REQUIRE(vertices.valuePoints.size() == 4);
+    REQUIRE(vertices.offsets.size() == 2);
+}
+
+
+TEST_CASE("Vertices compare by integer keys", "[vertex]")
+{
+    iris::ValuePoints two(2);
+    iris::ValuePoints four(4);
+
+    iris::VertexSet vertices;
+    vertices.Add({1.2, 3.7}, two.cbegin(), two.cend());
+    vertices.Add({1.9, 3.1}, four.cbegin(), four.cend());
+    vertices.Add({2.1, 3.1}, two.cbegin(), two.cend());
+
+    REQUIRE(vertices.size() == 3);
+    REQUIRE(vertices.offsets.back() == 8);
+
+    REQUIRE(vertices.IsSame(0, 1));
+    REQUIRE(!vertices.IsSame(1, 2));
+
+    // Vertices with the same key are ordered by count.
+    REQUIRE(vertices.IsLess(0, 1));
+    REQUIRE(vertices.IsGreater(1, 0));
+    REQUIRE(vertices.IsLess(1, 2));
+}
+
+
+TEST_CASE("Vertex index finds the nearest vertex", "[vertex]")
+{
+    auto maximumDistance = GENERATE(0.5, 4.0, 25.0);
+
+    // Few vertices make cells much larger than the maximum distance.
+    auto vertexCount = GENERATE(3, 400);
+
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> coordinate(-50.0, 250.0);
+
+    iris::ValuePoints noValuePoints;
+    iris::VertexSet vertices;
+
+    for (int index = 0; index < vertexCount; ++index)
+    {
+        vertices.Add(
+            {coordinate(generator), coordinate(generator)},
+            noValuePoints.cbegin(),
+            noValuePoints.cend());
+    }
+
+    iris::VertexIndex vertexIndex(vertices, maximumDistance);
+
+    for (int query = 0; query < 2000; ++query)
+    {
+        tau::Point2d<double> candidate(
+            coordinate(generator),
+            coordinate(generator));
+
+        std::optional<size_t> expected;
+        double nearest = maximumDistance;
+
+        for (size_t index = 0; index < vertices.size(); ++index)
+        {
+            double distance = candidate.Distance(vertices.GetPoint(index));
+
+            if (distance < nearest)
+            {
+                nearest = distance;
+                expected = index;
+            }
+        }
+
+        REQUIRE(vertexIndex.FindVertex(candidate) == expected);
+    }
+}